@@ -0,0 +1,90 @@
+/**
+ *  @brief
+ *  @details   8254 channel 0 runs at 1.19318 mhz or ~ 838.0965 nsecs / count
+ *  In mode 2 the counter falls from 65535 to 0 once per BIOS tick and IRQ 0 fires at 0,
+ *  so elapsed = ticks * 65536 + (65536 - count) with the latch taken between the two reads.
+ */
+#include <stdint.h>
+
+#include "bios_pit_timer.h"
+#include "bios_timer_io_constants.h"
+
+static void private_bios_pit_program(uint8_t mode, uint16_t divisor) {
+	__asm {
+		.8086
+		pushf
+		cli
+
+		mov		al, mode
+		out		BIOS_PIT_COMMAND_PORT, al
+		mov		ax, divisor					; 0 = 65536, 18.2 ticks per second
+		out		BIOS_PIT_CHANNEL0_PORT, al	; lobyte
+		mov		al, ah
+		out		BIOS_PIT_CHANNEL0_PORT, al	; hibyte
+
+		popf
+	}
+}
+
+void bios_pit_timer_init() {
+	private_bios_pit_program(BIOS_PIT_CHANNEL0_MODE2, 0);
+}
+
+void bios_pit_timer_restore() {
+	private_bios_pit_program(BIOS_PIT_CHANNEL0_MODE3, 0);
+}
+
+void bios_pit_timer_rate(uint16_t divisor) {
+	private_bios_pit_program(BIOS_PIT_CHANNEL0_MODE2, divisor);
+}
+
+/**
+* @brief Latch channel 0, read the countdown and the BDA ticks with interrupts off
+* @note If IRQ 0 is pending in the 8259 IRR the counter has wrapped but INT 08h has not yet
+* incremented 40:6C - the tick is added here so the count never runs backwards
+*/
+bios_pit_count_t bios_pit_timer_read() {
+	uint16_t count = 0;
+	uint16_t ticks_lo = 0;
+	uint16_t ticks_hi = 0;
+	uint8_t irr = 0;
+	__asm {
+		.8086
+		pushf
+		push	ds
+		cli
+
+		mov		al, BIOS_PIT_LATCH_CHANNEL0
+		out		BIOS_PIT_COMMAND_PORT, al	; freeze the count
+		in		al, BIOS_PIT_CHANNEL0_PORT	; lobyte
+		mov		ah, al
+		in		al, BIOS_PIT_CHANNEL0_PORT	; hibyte
+		xchg	al, ah
+		mov		count, ax
+
+		mov		al, BIOS_PIC_READ_IRR
+		out		BIOS_PIC_COMMAND_PORT, al
+		in		al, BIOS_PIC_COMMAND_PORT
+		mov		irr, al
+
+		mov		ax, BIOS_BDA_SEGMENT
+		mov		ds, ax
+		mov		ax, ds:[BIOS_BDA_TIMER_COUNTER]
+		mov		dx, ds:[BIOS_BDA_TIMER_COUNTER + 2]
+
+		pop		ds
+		mov		ticks_lo, ax
+		mov		ticks_hi, dx
+		popf
+	}
+	bios_ticks_since_midnight_t ticks = ((bios_ticks_since_midnight_t)ticks_hi << 16) | ticks_lo;
+	uint16_t elapsed = (uint16_t)(0 - count);	// counts since the last reload
+	if ((irr & 1) && elapsed < 0x8000) {
+		++ticks;								// wrapped, INT 08h still pending
+	}
+	return ((bios_pit_count_t)ticks << 16) + elapsed;
+}
+
+uint32_t bios_pit_counts_to_us(bios_pit_count_t counts) {
+	return (uint32_t)((counts * 1000000ULL) / BIOS_PIT_FREQUENCY);
+}
@@ -0,0 +1,29 @@
+/**
+ *  @brief    High resolution timing from 8253/8254 PIT channel 0
+ *  @details  Combines the BDA tick count at 40:6C with the latched 16 bit countdown of
+ *            channel 0 into a monotonic count of 1/1193182 second (~838 ns) units.
+ */
+#ifndef BIOS_PIT_TIMER_H
+#define	BIOS_PIT_TIMER_H
+
+#include "bios_timer_io_types.h"
+
+// Reprogram channel 0 to mode 2 (rate generator) keeping the 65536 divisor, so the
+// countdown falls by one per count rather than by two twice per tick as in mode 3
+void bios_pit_timer_init();
+
+// Return channel 0 to the BIOS default mode 3
+void bios_pit_timer_restore();
+
+// Run channel 0 in mode 2 at BIOS_PIT_FREQUENCY / divisor interrupts per second - the
+// INT 08h owner must then chain to the BIOS every 65536 / divisor ticks to keep the time
+// of day, and bios_pit_timer_read() is invalid until bios_pit_timer_restore()
+void bios_pit_timer_rate(uint16_t divisor);
+
+// Monotonic count since midnight in PIT counts - needs bios_pit_timer_init()
+bios_pit_count_t bios_pit_timer_read();
+
+// Convert a difference of PIT counts to microseconds
+uint32_t bios_pit_counts_to_us(bios_pit_count_t counts);
+
+#endif
@@ -18,4 +18,17 @@
 #define TICKS_PER_SECOND			18.206
 #define TICKS_PER_24HR				1800B0h
 
+// 8253/8254 Programmable Interval Timer - channel 0 drives IRQ 0 (INT 08h)
+#define BIOS_PIT_FREQUENCY			1193182UL	// Hz, ~838.0965 nsecs per count
+#define BIOS_PIT_CHANNEL0_PORT		40h
+#define BIOS_PIT_COMMAND_PORT		43h
+#define BIOS_PIT_LATCH_CHANNEL0		00h			// counter latch command, channel 0
+#define BIOS_PIT_CHANNEL0_MODE2		34h			// channel 0, lobyte/hibyte, mode 2 rate generator, binary
+#define BIOS_PIT_CHANNEL0_MODE3		36h			// channel 0, lobyte/hibyte, mode 3 square wave (BIOS default)
+#define BIOS_PIC_COMMAND_PORT		20h
+#define BIOS_PIC_READ_IRR			0Ah			// OCW3 - next read of port 20h returns the IRR
+#define BIOS_PIC_EOI				20h			// OCW2 - non specific end of interrupt
+#define BIOS_BDA_SEGMENT			40h
+#define BIOS_BDA_TIMER_COUNTER		6Ch			// dword ticks since midnight
+
 #endif
@@ -5,4 +5,6 @@
 
 typedef uint32_t bios_ticks_since_midnight_t;
 
+typedef uint64_t bios_pit_count_t;     // ticks * 65536 + elapsed PIT counts, ~838 ns each
+
 #endif
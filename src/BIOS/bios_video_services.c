@@ -8,6 +8,7 @@
 
 #include "bios_video_services_constants.h"
 #include "bios_video_services.h"
+#include "../TDD/tdd_counters.h"
 
 /**
 * @brief INT 10,0 - Set Video Mode
@@ -16,6 +17,7 @@
 * @see bios_video_services_constants.h enum type
 */
 void bios_set_video_mode(uint8_t mode) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	__asm {
 		.8086
 		pushf                                ; preserve what int BIOS functions may not
@@ -57,6 +59,7 @@ void bios_set_video_mode(uint8_t mode) {
  *	VGA	 50	    06		 07	      08
  */
 void bios_set_cursor_type(uint8_t start_scan_line, uint8_t end_scan_line) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
     __asm {
         .8086
         pushf                                ; preserve what int BIOS functions may not
@@ -82,6 +85,7 @@ void bios_set_cursor_type(uint8_t start_scan_line, uint8_t end_scan_line) {
  *	- 80x25 uses coordinates 0,0 to 24,79;	40x25 uses 0,0 to 24,39
  */
 void bios_set_cursor_position(uint8_t x, uint8_t y, uint8_t video_page) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
     __asm {
         .8086
         pushf                                ; preserve what int BIOS functions may not
@@ -109,6 +113,7 @@ void bios_set_cursor_position(uint8_t x, uint8_t y, uint8_t video_page) {
  *	DL = column
  */
 void bios_get_cursor_position_and_size(bios_cursor_state_t* state, uint8_t video_page) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
     __asm {
         .8086
         pushf                                ; preserve what int BIOS functions may not
@@ -128,6 +133,75 @@ void bios_get_cursor_position_and_size(bios_cursor_state_t* state, uint8_t video
 	}
 }
 
+/**
+* @brief INT 10,6 - Scroll Window Up
+*	AH = 06
+*	AL = number of lines to scroll, previous lines are blanked, if 0 or AL > screen size, window is blanked
+*	BH = attribute to be used on blank line
+*	CH = row of upper left corner of scroll window
+*	CL = column of upper left corner of scroll window
+*	DH = row of lower right corner of scroll window
+*	DL = column of lower right corner of scroll window
+*	@note 1. in video mode 4 (300x200 4 color) on the EGA, MCGA and VGA this function scrolls page 0 regardless of the current page
+*	@note 2. some older CGA BIOS blank the entire window when AL > 0 - slow snow-free video RAM access is the BIOS's problem
+*/
+void bios_scroll_active_page_up(uint8_t lines, char attr, uint8_t left, uint8_t top, uint8_t right, uint8_t bottom) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
+	__asm {
+		.8086
+		pushf                                ; preserve what int BIOS functions may not
+		push    ds                           ; due to unreliable behaviour
+		push	bp							 ; some BIOS destroy BP
+
+		mov		al, lines
+		mov		bh, attr
+		mov		ch, top
+		mov		cl, left
+		mov		dh, bottom
+		mov		dl, right
+		mov		ah, BIOS_SCROLL_ACTIVE_PAGE_UP
+		int		BIOS_VIDEO_SERVICES
+
+		pop		bp
+		pop 	ds
+		popf
+	}
+}
+
+/**
+* @brief INT 10,7 - Scroll Window Down
+*	AH = 07
+*	AL = number of lines to scroll, previous lines are blanked, if 0 or AL > screen size, window is blanked
+*	BH = attribute to be used on blank line
+*	CH = row of upper left corner of scroll window
+*	CL = column of upper left corner of scroll window
+*	DH = row of lower right corner of scroll window
+*	DL = column of lower right corner of scroll window
+*	@note in video mode 4 (300x200 4 color) on the EGA, MCGA and VGA this function scrolls page 0 regardless of the current page
+*/
+void bios_scroll_active_page_down(uint8_t lines, char attr, uint8_t left, uint8_t top, uint8_t right, uint8_t bottom) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
+	__asm {
+		.8086
+		pushf                                ; preserve what int BIOS functions may not
+		push    ds                           ; due to unreliable behaviour
+		push	bp							 ; some BIOS destroy BP
+
+		mov		al, lines
+		mov		bh, attr
+		mov		ch, top
+		mov		cl, left
+		mov		dh, bottom
+		mov		dl, right
+		mov		ah, BIOS_SCROLL_ACTIVE_PAGE_DOWN
+		int		BIOS_VIDEO_SERVICES
+
+		pop		bp
+		pop 	ds
+		popf
+	}
+}
+
 /**
 * @brief INT 10,8 - Read Character and Attribute at Cursor Position
 *	AH = 08
@@ -139,6 +213,7 @@ void bios_get_cursor_position_and_size(bios_cursor_state_t* state, uint8_t video
 * @note 2. video mode 4 (300x200 4 color) on the EGA, MCGA and VGA this function works only on page zero
 */
 uint16_t bios_read_character_and_attribute_at_cursor(uint8_t video_page) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	uint16_t char_attr_pair;
 	__asm {
         .8086
@@ -166,6 +241,7 @@ uint16_t bios_read_character_and_attribute_at_cursor(uint8_t video_page) {
 *	@note 2. in graphics mode (except mode 13h), if BL bit 7=1 then value of BL is XOR'ed with the background color
 */
 void bios_write_character_and_attribute_at_cursor(char chr, char attr, uint16_t count, uint8_t video_page) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	__asm {
         .8086
         pushf                                ; preserve what int BIOS functions may not
@@ -195,6 +271,7 @@ void bios_write_character_and_attribute_at_cursor(char chr, char attr, uint16_t
 *	@note 3. colour ignored in text modes
 */
 void bios_write_character_at_cursor(char chr, uint8_t foreground_colour, uint16_t count, uint8_t video_page) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	__asm {
         .8086
         pushf                                ; preserve what int BIOS functions may not
@@ -223,6 +300,7 @@ void bios_write_character_at_cursor(char chr, uint8_t foreground_colour, uint16_
 *	@note 3. for some older BIOS (10/19/81), the BH register must point to the currently displayed page
 */
 void bios_write_text_teletype_mode(char chr, uint8_t foreground_colour, uint8_t video_page) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	__asm {
         .8086
         pushf                                ; preserve what int BIOS functions may not
@@ -257,6 +335,7 @@ void bios_write_text_teletype_mode(char chr, uint8_t foreground_colour, uint8_t
 * with bit 7 of the requested mode (in AL) set to 1
 */
 void bios_get_video_state(bios_video_state_t* state) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	__asm {
 		.8086
 		pushf
@@ -302,6 +381,7 @@ void bios_get_video_state(bios_video_state_t* state) {
 *  @note If upon return from this call, BL>4, then must be running on a CGA or MDA (not an EGA or VGA).
 */
 uint8_t bios_return_video_configuration_information(bios_video_subsystem_config_t* config) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	uint8_t e = 0;
 	__asm {
 		.8086
@@ -416,6 +496,7 @@ uint8_t bios_return_video_configuration_information(bios_video_subsystem_config_
 * -----------------------------------------------------------------------------------------------------
 */
 uint8_t bios_helper_video_subsytem_configuration(uint8_t request, uint8_t setting) {
+	TDD_COUNT(TDD_COUNTER_BIOS_VIDEO);
 	uint8_t e = 0;
 	__asm {
 		.8086
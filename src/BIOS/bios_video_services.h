@@ -25,7 +25,10 @@ void bios_get_cursor_position_and_size(bios_cursor_state_t* state, uint8_t video
 // INT 10,4 - Read light pen
 // INT 10,5 - Select active display page
 // INT 10,6 - Scroll active page up
+void bios_scroll_active_page_up(uint8_t lines, char attr, uint8_t left, uint8_t top, uint8_t right, uint8_t bottom);
+
 // INT 10,7 - Scroll active page down
+void bios_scroll_active_page_down(uint8_t lines, char attr, uint8_t left, uint8_t top, uint8_t right, uint8_t bottom);
 
 // INT 10,8 - Read character and attribute at cursor
 uint16_t bios_read_character_and_attribute_at_cursor(uint8_t video_page);
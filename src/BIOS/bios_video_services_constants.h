@@ -13,8 +13,8 @@
 #define BIOS_READ_CURSOR_POSITION_SIZE              3
 //READ_LIGHT_PEN
 //SELECT_ACTIVE_DISPLAY_PAGE
-//SCROLL_ACTIVE_PAGE_UP
-//SCROLL_ACTIVE_PAGE_DOWN
+#define BIOS_SCROLL_ACTIVE_PAGE_UP                  6
+#define BIOS_SCROLL_ACTIVE_PAGE_DOWN                7
 #define BIOS_READ_CHARACTER_AND_ATTRIBUTE_AT_CURSOR         8
 #define BIOS_WRITE_CHARACTER_AND_ATTRIBUTE_AT_CURSOR        9
 #define BIOS_WRITE_CHARACTER_AT_CURRENT_CURSOR              0Ah
@@ -5,10 +5,13 @@
 #include "../BIOS/bios_video_services.h"
 #include "bios_video_services_constants.h"
 #include "bios_video_services_types.h"
+#include "bios_pit_timer.h"
 #include <stdio.h>
 
 #define BIOS_VIDEO_TESTS &bios_video_services
 
+#define BIOS_TIMER_TESTS &bios_pit_timer
+
 TEST(bios_video_services) {
 
      typedef union {
@@ -62,4 +65,20 @@ TEST(bios_video_services) {
     getchar();
     }
 
+TEST(bios_pit_timer) {
+    bios_pit_count_t start, now, previous;
+    bios_pit_timer_init();
+    start = previous = bios_pit_timer_read();
+    for (uint16_t i = 0; i < 10000; ++i) {      // monotonic across tick boundaries
+        now = bios_pit_timer_read();
+        EXPECT(now >= previous);
+        previous = now;
+    }
+        EXPECT(now > start);
+        EXPECT_EQ(bios_pit_counts_to_us(1193182ULL), 1000000UL);
+        EXPECT_EQ(bios_pit_counts_to_us(65536ULL), 54925UL);
+        printf("10000 reads took %lu us\n", bios_pit_counts_to_us(now - start));
+    bios_pit_timer_restore();
+}
+
 #endif
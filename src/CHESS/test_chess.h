@@ -3,11 +3,20 @@
 
 #include "../TDD/tdd_macros.h"
 #include "../CHESS/xt_bitboard.h"
+#include "../CHESS/xt_tt.h"
+#include "../DOS/dos_services_files.h"
 
 #define POPCNT_TEST_SUITE &test_xt_bit_count_basic, \
     &test_xt_bit_count_random_patterns, \
-    &test_xt_bit_count_edge_cases
-    //&test_xt_bit_count_null_ptr
+    &test_xt_bit_count_edge_cases, \
+    &test_xt_bit_count_null_ptr
+
+#define XT_TT_TESTS &test_xt_tt_store_probe, \
+    &test_xt_tt_snapshot, \
+    &test_xt_tt_counters
+
+#define POPCNT_BENCHMARKS &bench_xt_bit_count_sparse, \
+    &bench_xt_bit_count_dense
 
 TEST(test_xt_bit_count_basic) {
     // Test with 0 bits set
@@ -53,7 +62,81 @@ TEST(test_xt_bit_count_edge_cases) {
 
 TEST(test_xt_bit_count_null_ptr) {
     // Test with NULL pointer
-    EXPECT_EQ(xt_bit_count(NULL), 0); // assert fail
+    EXPECT_DEATH(xt_bit_count(NULL)); // assert fail
+}
+
+TEST(test_xt_tt_store_probe) {
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_HUGE, 96UL * 1024);
+    xt_tt_t tt;
+    xt_tt_entry_t entry;
+    ASSERT(xt_tt_init(&tt, arena, 8192));                   // 80KB of entries spans two segments
+    EXPECT(!xt_tt_probe(&tt, 0x123456789ABCDEF0ULL, &entry));
+    xt_tt_store(&tt, 0x123456789ABCDEF0ULL, 35, 12 | 28 << 6, 6, XT_TT_EXACT);
+    EXPECT(xt_tt_probe(&tt, 0x123456789ABCDEF0ULL, &entry));
+    EXPECT_EQ(entry.score, 35);
+    EXPECT_EQ(entry.depth, 6);
+    xt_tt_store(&tt, 0x123456789ABCDEF0ULL, 10, 0, 2, XT_TT_LOWER);  // shallower - kept out
+    xt_tt_probe(&tt, 0x123456789ABCDEF0ULL, &entry);
+    EXPECT_EQ(entry.depth, 6);
+    EXPECT(!xt_tt_probe(&tt, 0xFEDCBA989ABCDEF0ULL, &entry));        // same slot, different check
+    xt_tt_store(&tt, 0x0000000100001FFFULL, -7, 0, 1, XT_TT_UPPER);    // last slot
+    EXPECT(xt_tt_probe(&tt, 0x0000000100001FFFULL, &entry));
+    mem_arena_delete(arena);
+}
+
+TEST(test_xt_tt_snapshot) {
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_HUGE, 96UL * 1024);
+    xt_tt_t tt;
+    xt_tt_entry_t entry;
+    ASSERT(xt_tt_init(&tt, arena, 8192));
+    xt_tt_store(&tt, 0x0000000200001234ULL, 99, 0, 9, XT_TT_EXACT);
+    EXPECT(xt_tt_save(&tt, "XT.TT", NULL));
+    xt_tt_clear(&tt);
+    EXPECT(!xt_tt_probe(&tt, 0x0000000200001234ULL, &entry));
+    EXPECT(xt_tt_load(&tt, "XT.TT", NULL));                          // warm start
+    EXPECT(xt_tt_probe(&tt, 0x0000000200001234ULL, &entry));
+    EXPECT_EQ(entry.score, 99);
+    mem_arena_delete(arena);
+
+    arena = mem_arena_create(MEM_ARENA_POLICY_HUGE, 64UL * 1024);
+    ASSERT(xt_tt_init(&tt, arena, 4096));
+    EXPECT(!xt_tt_load(&tt, "XT.TT", NULL));                         // different size - cold start
+    EXPECT(!xt_tt_probe(&tt, 0x0000000200001234ULL, &entry));
+    dos_delete_file("XT.TT");
+    mem_arena_delete(arena);
+}
+
+TEST(test_xt_tt_counters) {
+#ifdef TDD_COUNTERS
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_HUGE, 16UL * 1024);
+    xt_tt_t tt;
+    xt_tt_entry_t entry;
+    ASSERT(xt_tt_init(&tt, arena, 1024));
+    tdd_counters_reset();
+    xt_tt_probe(&tt, 0x0000000100000042ULL, &entry);
+    xt_tt_store(&tt, 0x0000000100000042ULL, 0, 0, 1, XT_TT_EXACT);
+    xt_tt_probe(&tt, 0x0000000100000042ULL, &entry);
+    EXPECT_EQ(TDD_COUNTER(TDD_COUNTER_TT_PROBES), 2);
+    EXPECT_EQ(TDD_COUNTER(TDD_COUNTER_TT_HITS), 1);
+    tdd_counters_report(stdout);                                // tt.hit_permille: 500
+    mem_arena_delete(arena);
+#else
+    V(printf("Built without TDD_COUNTERS - skipped\n"););
+#endif
+}
+
+BENCH(bench_xt_bit_count_sparse) {
+    xt_bitboard_t bb = 0x8100000000000081ULL;   // corners
+    BENCH_LOOP {
+        TDD_BENCH_KEEP(xt_bit_count(&bb));
+    }
+}
+
+BENCH(bench_xt_bit_count_dense) {
+    xt_bitboard_t bb = 0xFFFF00000000FFFFULL;   // starting position
+    BENCH_LOOP {
+        TDD_BENCH_KEEP(xt_bit_count(&bb));
+    }
 }
 
 #endif
@@ -0,0 +1,80 @@
+#include "xt_position.h"
+#include "../TDD/tdd_counters.h"
+#include <assert.h>
+
+#define XT_SQUARE_BIT(square) ((xt_bitboard_t)1 << (square))
+
+void xt_position_clear(xt_position_t* position) {
+    assert(position && "NULL position!");
+    for(uint8_t c = 0; c < XT_COLOURS; ++c) {
+        for(uint8_t t = 0; t < XT_PIECE_TYPES; ++t) {
+            position->pieces[c][t] = 0;
+        }
+    }
+}
+
+void xt_position_initial(xt_position_t* position) {
+    assert(position && "NULL position!");
+    position->pieces[XT_WHITE][XT_PAWN]   = 0x000000000000FF00ULL;
+    position->pieces[XT_WHITE][XT_KNIGHT] = 0x0000000000000042ULL;
+    position->pieces[XT_WHITE][XT_BISHOP] = 0x0000000000000024ULL;
+    position->pieces[XT_WHITE][XT_ROOK]   = 0x0000000000000081ULL;
+    position->pieces[XT_WHITE][XT_QUEEN]  = 0x0000000000000008ULL;
+    position->pieces[XT_WHITE][XT_KING]   = 0x0000000000000010ULL;
+    position->pieces[XT_BLACK][XT_PAWN]   = 0x00FF000000000000ULL;
+    position->pieces[XT_BLACK][XT_KNIGHT] = 0x4200000000000000ULL;
+    position->pieces[XT_BLACK][XT_BISHOP] = 0x2400000000000000ULL;
+    position->pieces[XT_BLACK][XT_ROOK]   = 0x8100000000000000ULL;
+    position->pieces[XT_BLACK][XT_QUEEN]  = 0x0800000000000000ULL;
+    position->pieces[XT_BLACK][XT_KING]   = 0x1000000000000000ULL;
+}
+
+xt_bitboard_t xt_position_occupancy(const xt_position_t* position) {
+    assert(position && "NULL position!");
+    xt_bitboard_t occupied = 0;
+    for(uint8_t c = 0; c < XT_COLOURS; ++c) {
+        for(uint8_t t = 0; t < XT_PIECE_TYPES; ++t) {
+            occupied |= position->pieces[c][t];
+        }
+    }
+    return occupied;
+}
+
+bool xt_position_piece_at(const xt_position_t* position, xt_square_t square, xt_colour_t* colour, xt_piece_type_t* type) {
+    assert(position && "NULL position!");
+    assert(square < 64 && "OUT OF RANGE square!");
+    xt_bitboard_t bit = XT_SQUARE_BIT(square);
+    for(uint8_t c = 0; c < XT_COLOURS; ++c) {
+        for(uint8_t t = 0; t < XT_PIECE_TYPES; ++t) {
+            if(position->pieces[c][t] & bit) {
+                if(colour) {
+                    *colour = (xt_colour_t)c;
+                }
+                if(type) {
+                    *type = (xt_piece_type_t)t;
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void xt_position_move(xt_position_t* position, xt_square_t from, xt_square_t to) {
+    assert(position && "NULL position!");
+    assert(from < 64 && to < 64 && "OUT OF RANGE square!");
+    TDD_COUNT(TDD_COUNTER_MAKE);
+    xt_bitboard_t from_bit = XT_SQUARE_BIT(from);
+    xt_bitboard_t to_bit = XT_SQUARE_BIT(to);
+    for(uint8_t c = 0; c < XT_COLOURS; ++c) {
+        for(uint8_t t = 0; t < XT_PIECE_TYPES; ++t) {
+            xt_bitboard_t* bb = &position->pieces[c][t];
+            if(*bb & from_bit) {
+                *bb = (*bb & ~from_bit) | to_bit;
+            }
+            else {
+                *bb &= ~to_bit;     // capture
+            }
+        }
+    }
+}
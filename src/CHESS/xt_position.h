@@ -0,0 +1,37 @@
+/**
+ * @file xt_position.h
+ * @brief Piece placement built from per colour, per piece type bitboards
+ */
+#ifndef XT_POSITION_H
+#define XT_POSITION_H
+
+#include <stdbool.h>
+#include "xt_types.h"
+
+/**
+ * @brief Empties every bitboard of the position
+ */
+void xt_position_clear(xt_position_t* position);
+
+/**
+ * @brief Sets up the standard starting position
+ */
+void xt_position_initial(xt_position_t* position);
+
+/**
+ * @brief Union of all twelve piece bitboards
+ */
+xt_bitboard_t xt_position_occupancy(const xt_position_t* position);
+
+/**
+ * @brief Finds the piece standing on square
+ * @return false if the square is empty (colour and type are left untouched)
+ */
+bool xt_position_piece_at(const xt_position_t* position, xt_square_t square, xt_colour_t* colour, xt_piece_type_t* type);
+
+/**
+ * @brief Moves whatever stands on from to to, capturing anything already on to (no rules are checked)
+ */
+void xt_position_move(xt_position_t* position, xt_square_t from, xt_square_t to);
+
+#endif
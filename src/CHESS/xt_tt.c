@@ -0,0 +1,116 @@
+#include "xt_tt.h"
+#include "../MEM/mem_constants.h"
+#include "../MEM/mem_tools.h"
+#include "../TDD/tdd_counters.h"
+
+#include <assert.h>
+#include <string.h>
+
+static xt_tt_entry_t* private_xt_tt_slot(const xt_tt_t* tt, xt_hash_t hash) {
+    uint32_t index = (uint32_t)hash & tt->mask;    // normalized so an entry never straddles a segment
+    return (xt_tt_entry_t*)mem_linear_to_pointer(mem_linear_address(tt->header + 1) + index * sizeof(xt_tt_entry_t));
+}
+
+static void private_xt_tt_header(xt_tt_t* tt, uint32_t count) {
+    tt->header->magic = XT_TT_MAGIC;
+    tt->header->version = XT_TT_VERSION;
+    tt->header->entry_size = sizeof(xt_tt_entry_t);
+    tt->header->count = count;
+}
+
+uint32_t xt_tt_bytes(const xt_tt_t* tt) {
+    assert(tt && "NULL table!");
+    return sizeof(xt_tt_header_t) + (tt->mask + 1) * sizeof(xt_tt_entry_t);
+}
+
+bool xt_tt_init(xt_tt_t* tt, mem_arena_t* arena, uint32_t count) {
+    assert(tt && "NULL table!");
+    assert(arena && "NULL arena!");
+    assert(count && !(count & (count - 1)) && "COUNT must be a power of two!");
+    assert(mem_arena_policy(arena) != MEM_ARENA_POLICY_EMS && "EMS memory has no real-mode address!");
+    tt->header = NULL;
+    if (mem_arena_policy(arena) == MEM_ARENA_POLICY_EMS) {
+        return false;
+    }
+    mem_arena_mark_t mark = mem_arena_mark(arena);
+    tt->mask = count - 1;
+    uint32_t remaining = xt_tt_bytes(tt);
+    char* end = NULL;
+    while (remaining) {     // contiguous pieces - a single allocation is limited to one segment
+        uint16_t chunk = (remaining < MEM_FILE_CHUNK_SIZE) ? (uint16_t)remaining : MEM_FILE_CHUNK_SIZE;
+        char* piece = (char*)mem_arena_alloc(arena, chunk);
+        if (!piece || (end && mem_diff_linear(piece, end) != 0)) {   // a new chained block or a segment wrap
+            mem_arena_rewind(arena, mark);
+            tt->header = NULL;
+            return false;
+        }
+        if (!tt->header) {
+            tt->header = (xt_tt_header_t*)piece;
+        }
+        end = (char*)mem_linear_to_pointer(mem_linear_address(piece) + chunk);
+        remaining -= chunk;
+    }
+    private_xt_tt_header(tt, count);
+    xt_tt_clear(tt);
+    return true;
+}
+
+void xt_tt_clear(xt_tt_t* tt) {
+    assert(tt && tt->header && "NULL table!");
+    uint32_t linear = mem_linear_address(tt->header + 1);
+    uint32_t remaining = (tt->mask + 1) * sizeof(xt_tt_entry_t);
+    while (remaining) {
+        uint16_t chunk = (remaining < MEM_FILE_CHUNK_SIZE) ? (uint16_t)remaining : MEM_FILE_CHUNK_SIZE;
+        memset(mem_linear_to_pointer(linear), 0, chunk);
+        linear += chunk;
+        remaining -= chunk;
+    }
+}
+
+void xt_tt_store(xt_tt_t* tt, xt_hash_t hash, int16_t score, uint16_t move, uint8_t depth, xt_tt_bound_t bound) {
+    assert(tt && tt->header && "NULL table!");
+    xt_tt_entry_t* slot = private_xt_tt_slot(tt, hash);
+    uint32_t check = (uint32_t)(hash >> 32);
+    if (slot->bound != XT_TT_EMPTY && slot->check == check && slot->depth > depth) {
+        return;     // keep the deeper result for the same position
+    }
+    slot->check = check;
+    slot->score = score;
+    slot->move = move;
+    slot->depth = depth;
+    slot->bound = (uint8_t)bound;
+}
+
+bool xt_tt_probe(const xt_tt_t* tt, xt_hash_t hash, xt_tt_entry_t* entry) {
+    assert(tt && tt->header && "NULL table!");
+    assert(entry && "NULL entry!");
+    const xt_tt_entry_t* slot = private_xt_tt_slot(tt, hash);
+    TDD_COUNT(TDD_COUNTER_TT_PROBES);
+    if (slot->bound == XT_TT_EMPTY || slot->check != (uint32_t)(hash >> 32)) {
+        return false;
+    }
+    TDD_COUNT(TDD_COUNTER_TT_HITS);
+    *entry = *slot;
+    return true;
+}
+
+bool xt_tt_save(const xt_tt_t* tt, const char* path_name, tdd_progress_t* progress) {
+    assert(tt && tt->header && "NULL table!");
+    return mem_save_huge_to_file(path_name, (char*)tt->header, xt_tt_bytes(tt), progress) == xt_tt_bytes(tt);
+}
+
+bool xt_tt_load(xt_tt_t* tt, const char* path_name, tdd_progress_t* progress) {
+    assert(tt && tt->header && "NULL table!");
+    uint32_t count = tt->mask + 1;
+    dos_file_size_t loaded = mem_load_huge_from_file(path_name, (char*)tt->header, xt_tt_bytes(tt), progress);
+    if (loaded == xt_tt_bytes(tt)
+        && tt->header->magic == XT_TT_MAGIC
+        && tt->header->version == XT_TT_VERSION
+        && tt->header->entry_size == sizeof(xt_tt_entry_t)
+        && tt->header->count == count) {
+        return true;
+    }
+    private_xt_tt_header(tt, count);    // cold start rather than a half loaded table
+    xt_tt_clear(tt);
+    return false;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file xt_tt.h
+ * @brief Transposition table held in a huge arena, with snapshots to disk
+ * @note The table is preceded in memory by its file header, so a snapshot is one
+ *       sequential chunked write and a warm start one sequential chunked read.
+ */
+#ifndef XT_TT_H
+#define XT_TT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../MEM/mem_arena.h"
+#include "../TDD/tdd_progress.h"
+
+#define XT_TT_MAGIC     0x54545458UL    // "XTTT"
+#define XT_TT_VERSION   1
+
+typedef uint64_t xt_hash_t;
+
+typedef enum {
+    XT_TT_EMPTY,
+    XT_TT_EXACT,
+    XT_TT_LOWER,        // fail high - score is a lower bound
+    XT_TT_UPPER         // fail low - score is an upper bound
+} xt_tt_bound_t;
+
+/**
+ * @brief one slot - 10 bytes, the low hash bits are implied by the slot index
+ */
+typedef struct {
+    uint32_t check;     // high 32 bits of the hash
+    int16_t score;
+    uint16_t move;      // from | to << 6 | promotion << 12
+    uint8_t depth;
+    uint8_t bound;      // xt_tt_bound_t
+} xt_tt_entry_t;
+
+/**
+ * @brief snapshot file header, also the first bytes of the table in memory
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t count;
+} xt_tt_header_t;
+
+typedef struct {
+    xt_tt_header_t* header;     // header followed by count entries
+    uint32_t mask;              // count - 1
+} xt_tt_t;
+
+/**
+ * @brief Carves a cleared table of count (a power of two) entries from arena
+ * @note Use a MEM_ARENA_POLICY_HUGE arena for tables over 64KB
+ * @return false if the arena is too small, EMS backed, or cannot hand out the table
+ *         as one linear block (a chained arena linking a new block, a segment wrap)
+ */
+bool xt_tt_init(xt_tt_t* tt, mem_arena_t* arena, uint32_t count);
+
+/**
+ * @brief Empties every slot
+ */
+void xt_tt_clear(xt_tt_t* tt);
+
+/**
+ * @brief Stores an entry, replacing the slot unless it holds a deeper search of the same position
+ */
+void xt_tt_store(xt_tt_t* tt, xt_hash_t hash, int16_t score, uint16_t move, uint8_t depth, xt_tt_bound_t bound);
+
+/**
+ * @brief Looks up hash
+ * @return false on a miss (entry is left untouched)
+ */
+bool xt_tt_probe(const xt_tt_t* tt, xt_hash_t hash, xt_tt_entry_t* entry);
+
+/**
+ * @brief Writes the table to path_name in 32KB chunks
+ * @param progress Advanced once per chunk, or NULL
+ * @return false if the file could not be written completely
+ */
+bool xt_tt_save(const xt_tt_t* tt, const char* path_name, tdd_progress_t* progress);
+
+/**
+ * @brief Reloads a snapshot written by xt_tt_save() into a table of the same size
+ * @param progress Advanced once per chunk, or NULL
+ * @return false (and an empty table) if the file is missing, short or from a different table
+ */
+bool xt_tt_load(xt_tt_t* tt, const char* path_name, tdd_progress_t* progress);
+
+/**
+ * @brief Snapshot size in bytes, header included
+ */
+uint32_t xt_tt_bytes(const xt_tt_t* tt);
+
+#endif
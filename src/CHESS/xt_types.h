@@ -10,4 +10,32 @@
  */
 typedef uint64_t xt_bitboard_t;
 
+/**
+ * @brief square index 0..63 - A1 is 0 (LSB) and H8 is 63 (MSB)
+ */
+typedef uint8_t xt_square_t;
+
+typedef enum {
+    XT_WHITE,
+    XT_BLACK,
+    XT_COLOURS
+} xt_colour_t;
+
+typedef enum {
+    XT_PAWN,
+    XT_KNIGHT,
+    XT_BISHOP,
+    XT_ROOK,
+    XT_QUEEN,
+    XT_KING,
+    XT_PIECE_TYPES
+} xt_piece_type_t;
+
+/**
+ * @brief piece placement as one bitboard per colour and piece type - 12 x 8 = 96 bytes
+ */
+typedef struct {
+    xt_bitboard_t pieces[XT_COLOURS][XT_PIECE_TYPES];
+} xt_position_t;
+
 #endif
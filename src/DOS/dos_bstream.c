@@ -0,0 +1,199 @@
+#include "dos_bstream.h"
+#include "dos_services_files.h"
+
+#include <assert.h>
+#include <string.h>
+
+static bool private_dos_bstream_position(dos_bstream_t* stream, dos_file_position_t position) {
+    if (stream->fpos != position) {     // skip redundant INT 21,42 calls
+        stream->fpos = dos_move_file_pointer(stream->fhandle, position, FSEEK_SET);
+    }
+    return stream->fpos == position;
+}
+
+static void private_dos_bstream_restart(dos_bstream_t* stream, dos_file_position_t base) {
+    stream->base = base;
+    stream->pos = stream->count = 0;
+}
+
+static bool private_dos_bstream_fill(dos_bstream_t* stream) {
+    if (!dos_bstream_flush(stream)) {
+        return false;
+    }
+    private_dos_bstream_restart(stream, stream->base + stream->count);
+    if (!private_dos_bstream_position(stream, stream->base)) {
+        return false;
+    }
+    stream->count = dos_read_file(stream->fhandle, stream->buffer, stream->capacity);
+    stream->fpos += stream->count;
+    return stream->count > 0;
+}
+
+void dos_bstream_init(dos_bstream_t* stream, dos_file_handle_t fhandle, char* buffer, uint16_t capacity) {
+    assert(stream && "NULL stream!");
+    assert(buffer && capacity && "NULL buffer!");
+    stream->fhandle = fhandle;
+    stream->buffer = buffer;
+    stream->capacity = capacity;
+    stream->fpos = 0;
+    stream->dirty = false;
+    private_dos_bstream_restart(stream, 0);
+}
+
+bool dos_bstream_open(dos_bstream_t* stream, const char* path_name, dos_file_access_attributes_t access, char* buffer, uint16_t capacity) {
+    dos_file_handle_t fhandle = dos_open_file(path_name, access);
+    if (!fhandle) {
+        return false;
+    }
+    dos_bstream_init(stream, fhandle, buffer, capacity);
+    return true;
+}
+
+bool dos_bstream_create(dos_bstream_t* stream, const char* path_name, char* buffer, uint16_t capacity) {
+    dos_file_handle_t fhandle = dos_create_file(path_name, CREATE_READ_WRITE);
+    if (!fhandle) {
+        return false;
+    }
+    dos_bstream_init(stream, fhandle, buffer, capacity);
+    return true;
+}
+
+int dos_bstream_getc(dos_bstream_t* stream) {
+    assert(stream && "NULL stream!");
+    if (stream->pos == stream->count && !private_dos_bstream_fill(stream)) {
+        return DOS_BSTREAM_EOF;
+    }
+    return (unsigned char)stream->buffer[stream->pos++];
+}
+
+char* dos_bstream_gets(dos_bstream_t* stream, char* line, uint16_t size) {
+    assert(stream && "NULL stream!");
+    assert(line && size && "NULL line!");
+    uint16_t n = 0;
+    int chr = DOS_BSTREAM_EOF;
+    while (n + 1 < size && (chr = dos_bstream_getc(stream)) != DOS_BSTREAM_EOF && chr != '\n') {
+        line[n++] = (char)chr;
+    }
+    if (!n && chr == DOS_BSTREAM_EOF) {
+        line[0] = '\0';
+        return NULL;
+    }
+    if (n && line[n - 1] == '\r') {
+        --n;
+    }
+    line[n] = '\0';
+    return line;
+}
+
+uint16_t dos_bstream_read(dos_bstream_t* stream, char* dst, uint16_t nbytes) {
+    assert(stream && "NULL stream!");
+    assert(dst && "NULL destination!");
+    uint16_t done = 0;
+    while (done < nbytes) {
+        if (stream->pos == stream->count) {
+            if (nbytes - done >= stream->capacity) {    // bypass the buffer for bulk reads
+                if (!dos_bstream_flush(stream)) {
+                    break;
+                }
+                private_dos_bstream_restart(stream, stream->base + stream->count);
+                if (!private_dos_bstream_position(stream, stream->base)) {
+                    break;
+                }
+                uint16_t n = dos_read_file(stream->fhandle, dst + done, nbytes - done);
+                stream->fpos += n;
+                stream->base += n;
+                done += n;
+                break;
+            }
+            if (!private_dos_bstream_fill(stream)) {
+                break;
+            }
+        }
+        uint16_t n = stream->count - stream->pos;
+        if (n > nbytes - done) {
+            n = nbytes - done;
+        }
+        memcpy(dst + done, stream->buffer + stream->pos, n);
+        stream->pos += n;
+        done += n;
+    }
+    return done;
+}
+
+int dos_bstream_putc(dos_bstream_t* stream, char chr) {
+    return (dos_bstream_write(stream, &chr, 1) == 1) ? (unsigned char)chr : DOS_BSTREAM_EOF;
+}
+
+uint16_t dos_bstream_write(dos_bstream_t* stream, const char* src, uint16_t nbytes) {
+    assert(stream && "NULL stream!");
+    assert(src && "NULL source!");
+    uint16_t done = 0;
+    while (done < nbytes) {
+        if (stream->pos == stream->capacity) {
+            if (!dos_bstream_flush(stream)) {
+                break;
+            }
+            private_dos_bstream_restart(stream, stream->base + stream->count);
+        }
+        uint16_t n = stream->capacity - stream->pos;
+        if (n > nbytes - done) {
+            n = nbytes - done;
+        }
+        memcpy(stream->buffer + stream->pos, src + done, n);
+        stream->pos += n;
+        if (stream->pos > stream->count) {
+            stream->count = stream->pos;
+        }
+        stream->dirty = true;
+        done += n;
+    }
+    return done;
+}
+
+dos_file_position_t dos_bstream_seek(dos_bstream_t* stream, dos_file_position_t offset, uint8_t origin) {
+    assert(stream && "NULL stream!");
+    dos_file_position_t target = offset;
+    if (origin == FSEEK_CUR) {
+        target = dos_bstream_tell(stream) + offset;
+    }
+    else if (origin == FSEEK_END) {
+        dos_bstream_flush(stream);
+        stream->fpos = dos_move_file_pointer(stream->fhandle, 0, FSEEK_END);
+        target = stream->fpos + offset;
+    }
+    if (target >= stream->base && target <= stream->base + stream->count) {
+        stream->pos = (uint16_t)(target - stream->base);    // still buffered
+    }
+    else {
+        dos_bstream_flush(stream);
+        private_dos_bstream_restart(stream, target);
+    }
+    return target;
+}
+
+dos_file_position_t dos_bstream_tell(const dos_bstream_t* stream) {
+    assert(stream && "NULL stream!");
+    return stream->base + stream->pos;
+}
+
+bool dos_bstream_flush(dos_bstream_t* stream) {
+    assert(stream && "NULL stream!");
+    if (!stream->dirty) {
+        return true;
+    }
+    if (!private_dos_bstream_position(stream, stream->base)) {
+        return false;
+    }
+    uint16_t written = dos_write_file(stream->fhandle, stream->buffer, stream->count);
+    stream->fpos += written;
+    stream->dirty = false;
+    return written == stream->count;
+}
+
+dos_error_code_t dos_bstream_close(dos_bstream_t* stream) {
+    assert(stream && "NULL stream!");
+    dos_bstream_flush(stream);
+    dos_error_code_t err_code = dos_close_file(stream->fhandle);
+    stream->fhandle = 0;
+    return err_code;
+}
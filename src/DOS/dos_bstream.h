@@ -0,0 +1,113 @@
+/**
+ * @file dos_bstream.h
+ * @brief Buffered file streams over the DOS file handle services
+ * @details One caller-supplied buffer (e.g. from a mem_arena_t) serves both read-ahead
+ *          and write-behind, so line-by-line parsing of PGN/EPD files costs one
+ *          INT 21h per buffer instead of one per line.
+ */
+#ifndef DOS_BSTREAM_H
+#define DOS_BSTREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "dos_services_types.h"
+#include "dos_services_files_types.h"
+
+#define DOS_BSTREAM_EOF (-1)
+
+/**
+ * @brief Buffered stream state
+ * @note The buffer always mirrors file bytes [base, base + count) and pos is the
+ *       stream position within it. A dirty buffer is written back at base on flush.
+ */
+typedef struct {
+    dos_file_handle_t fhandle;      ///< Open DOS file handle
+    char* buffer;                   ///< Caller-supplied buffer
+    uint16_t capacity;              ///< Buffer size in bytes
+    uint16_t pos;                   ///< Stream position within the buffer
+    uint16_t count;                 ///< Valid bytes in the buffer
+    dos_file_position_t base;       ///< File position of buffer[0]
+    dos_file_position_t fpos;       ///< Where DOS thinks the file pointer is
+    bool dirty;                     ///< Buffer holds unwritten bytes
+} dos_bstream_t;
+
+/**
+ * @brief Wraps an already open handle
+ * @param stream Stream to initialise
+ * @param fhandle Open file handle positioned at the start of the file
+ * @param buffer Caller-owned buffer that outlives the stream
+ * @param capacity Buffer size in bytes (> 0)
+ */
+void dos_bstream_init(dos_bstream_t* stream, dos_file_handle_t fhandle, char* buffer, uint16_t capacity);
+
+/**
+ * @brief Opens an existing file (INT 21,3D) as a buffered stream
+ * @return true on success
+ */
+bool dos_bstream_open(dos_bstream_t* stream, const char* path_name, dos_file_access_attributes_t access, char* buffer, uint16_t capacity);
+
+/**
+ * @brief Creates or truncates a file (INT 21,3C) as a buffered stream
+ * @return true on success
+ */
+bool dos_bstream_create(dos_bstream_t* stream, const char* path_name, char* buffer, uint16_t capacity);
+
+/**
+ * @brief Reads one byte
+ * @return Byte value 0 - 255 or DOS_BSTREAM_EOF
+ */
+int dos_bstream_getc(dos_bstream_t* stream);
+
+/**
+ * @brief Reads one line, dropping the CR LF (or LF) terminator
+ * @param line Destination, always NUL terminated
+ * @param size Destination size - longer lines are split
+ * @return line or NULL if already at end of file
+ */
+char* dos_bstream_gets(dos_bstream_t* stream, char* line, uint16_t size);
+
+/**
+ * @brief Reads up to nbytes
+ * @return Bytes read (< nbytes only at end of file)
+ * @note Reads of a buffer or more with nothing buffered go straight to DOS
+ */
+uint16_t dos_bstream_read(dos_bstream_t* stream, char* dst, uint16_t nbytes);
+
+/**
+ * @brief Writes one byte
+ * @return The byte or DOS_BSTREAM_EOF on error
+ */
+int dos_bstream_putc(dos_bstream_t* stream, char chr);
+
+/**
+ * @brief Writes nbytes
+ * @return Bytes accepted
+ */
+uint16_t dos_bstream_write(dos_bstream_t* stream, const char* src, uint16_t nbytes);
+
+/**
+ * @brief Moves the stream position (FSEEK_SET, FSEEK_CUR, FSEEK_END)
+ * @return New position from the start of the file
+ * @note Seeks inside the buffered bytes keep the read-ahead and cost no INT 21h
+ */
+dos_file_position_t dos_bstream_seek(dos_bstream_t* stream, dos_file_position_t offset, uint8_t origin);
+
+/**
+ * @brief Gets the stream position
+ */
+dos_file_position_t dos_bstream_tell(const dos_bstream_t* stream);
+
+/**
+ * @brief Writes any buffered bytes to the file
+ * @return true if nothing was lost
+ */
+bool dos_bstream_flush(dos_bstream_t* stream);
+
+/**
+ * @brief Flushes and closes the file handle (INT 21,3E)
+ * @return 0 or the DOS error code
+ */
+dos_error_code_t dos_bstream_close(dos_bstream_t* stream);
+
+#endif
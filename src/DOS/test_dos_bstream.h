@@ -0,0 +1,78 @@
+/**
+ * @file test_dos_bstream.h
+ * @brief Test suite for buffered DOS file streams
+ * @ingroup tdd_framework
+ */
+#ifndef TEST_DOS_BSTREAM_H
+#define TEST_DOS_BSTREAM_H
+
+#include "dos_bstream.h"
+#include "../TDD/tdd_macros.h"
+#include "../MEM/mem_arena.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DOS_BSTREAM_TESTS &test_bstream_lines, \
+    &test_bstream_seek
+
+#define TEST_BSTREAM_FILE "BSTREAM.TMP"
+
+/**
+ * @brief Lines written through a small buffer read back intact
+ * @details The 16 byte buffer forces several flushes and refills per line
+ */
+TEST(test_bstream_lines)
+{
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_C, 256);
+    char* buffer = (char*)mem_arena_alloc(arena, 16);
+    char line[64];
+    dos_bstream_t stream;
+
+    ASSERT(dos_bstream_create(&stream, TEST_BSTREAM_FILE, buffer, 16));
+    EXPECT_EQ(dos_bstream_write(&stream, "1. e4 e5 2. Nf3 Nc6\r\n", 21), 21);
+    dos_bstream_putc(&stream, '*');
+    dos_bstream_putc(&stream, '\n');
+    EXPECT_EQ(dos_bstream_tell(&stream), 23);
+    EXPECT_EQ(dos_bstream_close(&stream), 0);
+
+    ASSERT(dos_bstream_open(&stream, TEST_BSTREAM_FILE, ACCESS_READ_ONLY, buffer, 16));
+    EXPECT(dos_bstream_gets(&stream, line, sizeof(line)) != NULL);
+    EXPECT(strcmp(line, "1. e4 e5 2. Nf3 Nc6") == 0);
+    EXPECT(dos_bstream_gets(&stream, line, sizeof(line)) != NULL);
+    EXPECT(strcmp(line, "*") == 0);
+    EXPECT(dos_bstream_gets(&stream, line, sizeof(line)) == NULL);
+    EXPECT_EQ(dos_bstream_getc(&stream), DOS_BSTREAM_EOF);
+    dos_bstream_close(&stream);
+
+    dos_delete_file(TEST_BSTREAM_FILE);
+    mem_arena_delete(arena);
+}
+
+/**
+ * @brief Seeking inside and outside the buffer, overwriting in place
+ */
+TEST(test_bstream_seek)
+{
+    char buffer[8];
+    char data[32];
+    dos_bstream_t stream;
+
+    ASSERT(dos_bstream_create(&stream, TEST_BSTREAM_FILE, buffer, sizeof(buffer)));
+    dos_bstream_write(&stream, "abcdefghijklmnopqrstuvwxyz", 26);
+    EXPECT_EQ(dos_bstream_seek(&stream, 2, FSEEK_SET), 2);
+    dos_bstream_putc(&stream, 'C');
+    EXPECT_EQ(dos_bstream_seek(&stream, -1, FSEEK_END), 25);
+    EXPECT_EQ(dos_bstream_getc(&stream), 'z');
+    dos_bstream_close(&stream);
+
+    ASSERT(dos_bstream_open(&stream, TEST_BSTREAM_FILE, ACCESS_READ_ONLY, buffer, sizeof(buffer)));
+    EXPECT_EQ(dos_bstream_read(&stream, data, sizeof(data)), 26);
+    EXPECT(memcmp(data, "abCdefghijklmnopqrstuvwxyz", 26) == 0);
+    dos_bstream_seek(&stream, 3, FSEEK_SET);
+    EXPECT_EQ(dos_bstream_getc(&stream), 'd');
+    dos_bstream_close(&stream);
+
+    dos_delete_file(TEST_BSTREAM_FILE);
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "mda_widget_board.h"
+#include "../mda_attributes.h"
+#include "../../CHESS/xt_bitboard.h"
+#include "../../CHESS/xt_position.h"
+#include <assert.h>
+
+static void mda_widget_board_paint_square(mda_widget_board_t* board, xt_square_t square) {
+    uint8_t file = square & 7;
+    uint8_t rank = square >> 3;
+    char glyphs[MDA_WIDGET_BOARD_SQUARE_WIDTH + 1] = "   ";
+    xt_colour_t colour;
+    xt_piece_type_t type;
+    if(xt_position_piece_at(&board->drawn, square, &colour, &type)) {
+        glyphs[MDA_WIDGET_BOARD_SQUARE_WIDTH / 2] = mda_widget_board_glyphs[colour][type];
+    }
+    mda_context_t* ctx = board->base.ctx;
+    char attr = ctx->attributes;
+    mda_set_attributes(ctx, ((file + rank) & 1) ? board->light_attr : board->dark_attr);    // A1 is dark
+    mda_write_span(
+        ctx,
+        board->base.x + file * MDA_WIDGET_BOARD_SQUARE_WIDTH,
+        board->base.y + 7 - rank,   // rank 8 at the top
+        glyphs
+    );
+    mda_set_attributes(ctx, attr);
+}
+
+void mda_widget_board_init(
+    mda_widget_board_t* board,
+    mda_widget_component_t* parent,
+    mda_context_t* ctx,
+    uint8_t x,
+    uint8_t y
+) {
+    assert(board && "NULL board!");
+    mda_widget_component_init(MDA_WIDGET_TYPE_BOARD, &board->base, parent, ctx, x, y, MDA_WIDGET_BOARD_WIDTH, MDA_WIDGET_BOARD_HEIGHT);
+    board->base.draw = mda_widget_board_draw;
+    xt_position_clear(&board->drawn);
+    board->has_drawn = false;
+    board->light_attr = MDA_REVERSE;
+    board->dark_attr = MDA_NORMAL;
+}
+
+mda_widget_board_t* mda_widget_board_create(
+    mem_arena_t* arena,
+    mda_widget_component_t* parent,
+    mda_context_t* ctx,
+    uint8_t x,
+    uint8_t y
+) {
+    assert(arena && "NULL memory arena!");
+    assert(mem_arena_policy(arena) != MEM_ARENA_POLICY_EMS && "EMS memory has no real-mode address!");
+    if (mem_arena_policy(arena) == MEM_ARENA_POLICY_EMS) {
+        return NULL;
+    }
+
+    mda_widget_board_t* board = (mda_widget_board_t*)mem_arena_calloc(arena, sizeof(mda_widget_board_t));
+    assert(board && "NULL board - arena allocation failed!");
+
+    mda_widget_board_init(board, parent, ctx, x, y);
+
+    return board;
+}
+
+void mda_widget_board_draw(mda_widget_component_t* comp) {
+    assert(comp && "NULL component!");
+    assert(mda_widget_is_typeof(comp->rtti, MDA_WIDGET_TYPE_BOARD) && "NOT a board widget!");
+    mda_widget_board_t* board = (mda_widget_board_t*)comp;
+    for(xt_square_t square = 0; square < 64; ++square) {
+        mda_widget_board_paint_square(board, square);
+    }
+    board->has_drawn = true;
+}
+
+uint8_t mda_widget_board_update(mda_widget_board_t* board, const xt_position_t* position) {
+    assert(board && "NULL board!");
+    assert(position && "NULL position!");
+    xt_bitboard_t changed = 0;
+    for(uint8_t c = 0; c < XT_COLOURS; ++c) {
+        for(uint8_t t = 0; t < XT_PIECE_TYPES; ++t) {
+            changed |= position->pieces[c][t] ^ board->drawn.pieces[c][t];
+        }
+    }
+    board->drawn = *position;
+    if(!board->has_drawn) {
+        mda_widget_board_draw(&board->base);
+        return 64;
+    }
+    uint8_t squares[64];
+    uint8_t count = xt_bit_positions(&changed, squares);
+    for(uint8_t i = 0; i < count; ++i) {
+        mda_widget_board_paint_square(board, squares[i]);
+    }
+    return count;
+}
@@ -0,0 +1,48 @@
+#ifndef MDA_WIDGET_BOARD_H
+#define MDA_WIDGET_BOARD_H
+
+#include "mda_widget_composite.h"
+#include "../../CHESS/xt_types.h"
+#include <stdbool.h>
+
+#define MDA_WIDGET_BOARD_SQUARE_WIDTH   3   // " P " keeps squares roughly square on an 80x25 screen
+#define MDA_WIDGET_BOARD_WIDTH          (8 * MDA_WIDGET_BOARD_SQUARE_WIDTH)
+#define MDA_WIDGET_BOARD_HEIGHT         8
+
+// white pieces upper case, black lower case, indexed by xt_piece_type_t
+static const char mda_widget_board_glyphs[XT_COLOURS][XT_PIECE_TYPES] = {
+    { 'P', 'N', 'B', 'R', 'Q', 'K' },
+    { 'p', 'n', 'b', 'r', 'q', 'k' }
+};
+
+typedef struct {
+    mda_widget_component_t base;
+    xt_position_t drawn;        // the position as last painted - diffed against on update
+    bool has_drawn;
+    char light_attr;            // squares are shaded by attribute alone
+    char dark_attr;
+} mda_widget_board_t;
+
+void mda_widget_board_init(
+    mda_widget_board_t* board,
+    mda_widget_component_t* parent,
+    mda_context_t* ctx,
+    uint8_t x,
+    uint8_t y
+);
+
+mda_widget_board_t* mda_widget_board_create(
+    mem_arena_t* arena,
+    mda_widget_component_t* parent,
+    mda_context_t* ctx,
+    uint8_t x,
+    uint8_t y
+);
+
+// repaint all 64 squares from the last position given to update
+void mda_widget_board_draw(mda_widget_component_t* comp);
+
+// repaint only the squares whose occupant differs from the last drawn position, returns squares repainted
+uint8_t mda_widget_board_update(mda_widget_board_t* board, const xt_position_t* position);
+
+#endif
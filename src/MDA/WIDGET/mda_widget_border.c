@@ -1,21 +1,47 @@
 #include "mda_widget_border.h"
 #include <assert.h>
 
-static void mda_widget_border_draw(mda_widget_border_t* widget) {
+void mda_widget_border_init(
+    mda_widget_border_t* widget,
+    mda_widget_component_t* parent,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height,
+    char* border_chars,
+    bool shrink_context
+) {
+    assert(widget && "NULL border!");
+    assert(parent && "NULL parent - the border draws on its context!");
+    assert(border_chars && "NULL border characters");
+    assert(width >= 2 && height >= 2 && "Border too small!");
+    mda_widget_component_init(MDA_WIDGET_TYPE_BORDER, &widget->base, parent, parent->ctx, x, y, width, height);
+    widget->base.draw = mda_widget_border_draw;
+    widget->border_chars = border_chars;
+    if(shrink_context) {
+        mda_set_context_frame(parent->ctx, x + 1, y + 1, width - 2, height - 2);
+    }
+}
+
+void mda_widget_border_draw(mda_widget_component_t* comp) {
+    assert(comp && "NULL component!");
+    assert(mda_widget_is_typeof(comp->rtti, MDA_WIDGET_TYPE_BORDER) && "NOT a border widget!");
+    mda_widget_border_t* widget = (mda_widget_border_t*)comp;
     assert(widget->border_chars && "NULL border characters");
 
+    mda_context_t* ctx = widget->base.ctx;
     uint8_t x = widget->base.x;
     uint8_t y = widget->base.y;
+    uint8_t right = x + widget->base.width - 1;
+    uint8_t bottom = y + widget->base.height - 1;
 
-    mda_write_char(widget->base.ctx, widget->border_chars[INDEX_TOP_LEFT]);
-    mda_write_row(widget->base.ctx, widget->border_chars[INDEX_HORIZONTAL], widget->base.width - 2);
-    mda_write_char(widget->base.ctx, widget->border_chars[INDEX_TOP_RIGHT]);
-    mda_cursor_to(widget->base.ctx, x, y + 1);
-    mda_write_column(widget->base.ctx, widget->border_chars[INDEX_VERTICAL], widget->base.height - 2);
-    mda_write_char(widget->base.ctx, widget->border_chars[INDEX_BOTTOM_LEFT]);
-    mda_write_row(widget->base.ctx, widget->border_chars[INDEX_HORIZONTAL], widget->base.width - 2);
-    mda_write_char(widget->base.ctx, widget->border_chars[INDEX_BOTTOM_RIGHT]);
-    mda_cursor_to(widget->base.ctx, x + widget->base.width - 1, y+ 1);
-    mda_write_column(widget->base.ctx, widget->border_chars[INDEX_VERTICAL], widget->base.height - 2);
-
+    // four runs and four corners rather than a char at a time
+    mda_fill_rect(ctx, x, y, 1, 1, widget->border_chars[INDEX_TOP_LEFT]);
+    mda_fill_rect(ctx, x + 1, y, widget->base.width - 2, 1, widget->border_chars[INDEX_HORIZONTAL]);
+    mda_fill_rect(ctx, right, y, 1, 1, widget->border_chars[INDEX_TOP_RIGHT]);
+    mda_write_vrun(ctx, x, y + 1, widget->border_chars[INDEX_VERTICAL], widget->base.height - 2);
+    mda_write_vrun(ctx, right, y + 1, widget->border_chars[INDEX_VERTICAL], widget->base.height - 2);
+    mda_fill_rect(ctx, x, bottom, 1, 1, widget->border_chars[INDEX_BOTTOM_LEFT]);
+    mda_fill_rect(ctx, x + 1, bottom, widget->base.width - 2, 1, widget->border_chars[INDEX_HORIZONTAL]);
+    mda_fill_rect(ctx, right, bottom, 1, 1, widget->border_chars[INDEX_BOTTOM_RIGHT]);
 }
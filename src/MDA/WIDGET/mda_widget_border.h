@@ -4,15 +4,12 @@
 #include "mda_widget_composite.h"
 #include <stdbool.h>
 
-typedef struct mda_widget_border_t mda_widget_border_t;
-
-static void mda_widget_border_draw(mda_widget_border_t* widget);
-
 typedef struct mda_widget_border_t {
     mda_widget_component_t base;
     char* border_chars;
 } mda_widget_border_t;
 
+// draws on the parent's context, shrink_context moves that context's frame inside the border
 void mda_widget_border_init(
     mda_widget_border_t* widget,
     mda_widget_component_t* parent,
@@ -24,4 +21,7 @@ void mda_widget_border_init(
     bool shrink_context
 );
 
+// four runs and four corners, clipped to the frame set by mda_widget_composite_redraw
+void mda_widget_border_draw(mda_widget_component_t* comp);
+
 #endif
@@ -2,6 +2,81 @@
 #include "mda_widget_constants.h"
 #include <assert.h>
 
+static mda_widget_rect_t private_mda_widget_frame(mda_widget_component_t* comp) {
+    mda_widget_rect_t frame = { comp->x, comp->y, comp->width, comp->height };
+    return frame;
+}
+
+static bool private_mda_widget_rect_intersects(mda_widget_rect_t a, mda_widget_rect_t b) {
+    return a.width && a.height && b.width && b.height
+        && a.x < (uint16_t)(b.x + b.width) && b.x < (uint16_t)(a.x + a.width)
+        && a.y < (uint16_t)(b.y + b.height) && b.y < (uint16_t)(a.y + a.height);
+}
+
+static mda_widget_rect_t private_mda_widget_rect_intersection(mda_widget_rect_t a, mda_widget_rect_t b) {
+    mda_widget_rect_t r = { 0, 0, 0, 0 };
+    if(!private_mda_widget_rect_intersects(a, b)) {
+        return r;
+    }
+    uint16_t right = ((uint16_t)(a.x + a.width) < (uint16_t)(b.x + b.width)) ? a.x + a.width : b.x + b.width;
+    uint16_t bottom = ((uint16_t)(a.y + a.height) < (uint16_t)(b.y + b.height)) ? a.y + a.height : b.y + b.height;
+    r.x = (a.x > b.x) ? a.x : b.x;
+    r.y = (a.y > b.y) ? a.y : b.y;
+    r.width = right - r.x;
+    r.height = bottom - r.y;
+    return r;
+}
+
+static mda_widget_rect_t private_mda_widget_rect_union(mda_widget_rect_t a, mda_widget_rect_t b) {
+    mda_widget_rect_t r;
+    uint16_t right = ((uint16_t)(a.x + a.width) > (uint16_t)(b.x + b.width)) ? a.x + a.width : b.x + b.width;
+    uint16_t bottom = ((uint16_t)(a.y + a.height) > (uint16_t)(b.y + b.height)) ? a.y + a.height : b.y + b.height;
+    r.x = (a.x < b.x) ? a.x : b.x;
+    r.y = (a.y < b.y) ? a.y : b.y;
+    r.width = right - r.x;
+    r.height = bottom - r.y;
+    return r;
+}
+
+static uint16_t private_mda_widget_rect_area(mda_widget_rect_t r) {
+    return (uint16_t)r.width * r.height;
+}
+
+/**
+ * @brief visit comp and then its children (painter's order) if comp intersects any damaged rectangle
+ * @note the context frame is narrowed to the component's frame within clip so span writes cannot stray
+ */
+// types whose struct starts with a mda_widget_composite_t
+static bool private_mda_widget_is_composite(const mda_widget_component_t* comp) {
+    return mda_widget_is_typeof(comp->rtti, MDA_WIDGET_TYPE_COMPOSITE) || mda_widget_is_typeof(comp->rtti, MDA_WIDGET_TYPE_PANEL);
+}
+
+static void private_mda_widget_redraw(mda_widget_component_t* comp, mda_widget_rect_t clip, const mda_widget_composite_t* root) {
+    mda_widget_rect_t frame = private_mda_widget_rect_intersection(private_mda_widget_frame(comp), clip);
+    bool damaged = false;
+    for(uint8_t i = 0; i < root->damage_count && !damaged; ++i) {
+        damaged = private_mda_widget_rect_intersects(frame, root->damage[i]);
+    }
+    if(!damaged) {
+        return;
+    }
+    if(comp->draw) {
+        mda_context_t saved = *comp->ctx;
+        comp->ctx->x = frame.x;
+        comp->ctx->y = frame.y;
+        comp->ctx->width = frame.width;
+        comp->ctx->height = frame.height;
+        comp->draw(comp);
+        *comp->ctx = saved;
+    }
+    if(private_mda_widget_is_composite(comp)) {
+        mda_widget_composite_t* composite = (mda_widget_composite_t*)comp;
+        for(uint8_t i = 0; i < composite->child_count; ++i) {
+            private_mda_widget_redraw(composite->children[i], frame, root);
+        }
+    }
+}
+
 void mda_widget_component_init(
     mda_widget_type_t type,
     mda_widget_component_t* comp,
@@ -21,6 +96,7 @@ void mda_widget_component_init(
     comp->y = y;
     comp->width = width;
     comp->height = height;
+    comp->draw = NULL;
 }
 
 mda_widget_component_t* mda_widget_component_create(
@@ -34,6 +110,10 @@ mda_widget_component_t* mda_widget_component_create(
     uint8_t height
 ) {
     assert(arena && "NULL memory arena!");
+    assert(mem_arena_policy(arena) != MEM_ARENA_POLICY_EMS && "EMS memory has no real-mode address!");
+    if (mem_arena_policy(arena) == MEM_ARENA_POLICY_EMS) {
+        return NULL;
+    }
 
     mda_widget_component_t* comp = (mda_widget_component_t*)mem_arena_calloc(arena, sizeof(mda_widget_component_t));
     assert(comp && "NULL component - arena allocation failed!");
@@ -56,7 +136,9 @@ void mda_widget_composite_init(
     assert(comp && "NULL composite!");
 
     mda_widget_component_init(type, &comp->component_base, parent, ctx, x, y, width, height);
+    assert(private_mda_widget_is_composite(&comp->component_base) && "NOT a composite type!");
 
+    comp->damage_count = 0;
     comp->child_count = 0;
     for (int i = 0; i < MDA_WIDGET_MAX_CHILDREN; i++) {
         comp->children[i] = NULL;
@@ -74,6 +156,10 @@ mda_widget_composite_t* mda_widget_composite_create(
     uint8_t height
 ) {
     assert(arena && "NULL memory arena!");
+    assert(mem_arena_policy(arena) != MEM_ARENA_POLICY_EMS && "EMS memory has no real-mode address!");
+    if (mem_arena_policy(arena) == MEM_ARENA_POLICY_EMS) {
+        return NULL;
+    }
 
     mda_widget_composite_t* comp = (mda_widget_composite_t*)mem_arena_calloc(arena, sizeof(mda_widget_composite_t));
     assert(comp && "NULL component - arena allocation failed!");
@@ -106,3 +192,50 @@ mda_widget_component_t* mda_widget_composite_remove(mda_widget_composite_t* pare
     }
     return NULL;
 }
+
+void mda_widget_invalidate(mda_widget_component_t* comp, mda_widget_rect_t rect) {
+    assert(comp && "NULL component!");
+    rect = private_mda_widget_rect_intersection(rect, private_mda_widget_frame(comp));
+    if(!rect.width || !rect.height) {
+        return;
+    }
+    while(comp->parent) {   // damage is only ever held by the root
+        comp = comp->parent;
+    }
+    assert(private_mda_widget_is_composite(comp) && "ROOT is not a composite!");
+    mda_widget_composite_t* root = (mda_widget_composite_t*)comp;
+    for(uint8_t i = 0; i < root->damage_count; ++i) {
+        if(private_mda_widget_rect_area(private_mda_widget_rect_intersection(rect, root->damage[i])) == private_mda_widget_rect_area(rect)) {
+            return;         // already covered
+        }
+    }
+    if(root->damage_count < MDA_WIDGET_MAX_DAMAGE) {
+        root->damage[root->damage_count++] = rect;
+        return;
+    }
+    uint8_t best = 0;       // full - merge into the rectangle that grows least
+    uint16_t best_growth = 0xFFFF;
+    for(uint8_t i = 0; i < root->damage_count; ++i) {
+        uint16_t growth = private_mda_widget_rect_area(private_mda_widget_rect_union(rect, root->damage[i])) - private_mda_widget_rect_area(root->damage[i]);
+        if(growth < best_growth) {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    root->damage[best] = private_mda_widget_rect_union(rect, root->damage[best]);
+}
+
+void mda_widget_invalidate_all(mda_widget_component_t* comp) {
+    assert(comp && "NULL component!");
+    mda_widget_invalidate(comp, private_mda_widget_frame(comp));
+}
+
+void mda_widget_composite_redraw(mda_widget_composite_t* root) {
+    assert(root && "NULL composite!");
+    assert(!root->component_base.parent && "NOT the root composite!");
+    if(!root->damage_count) {
+        return;
+    }
+    private_mda_widget_redraw(&root->component_base, private_mda_widget_frame(&root->component_base), root);
+    root->damage_count = 0;
+}
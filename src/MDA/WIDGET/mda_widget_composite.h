@@ -5,8 +5,8 @@
 #include "mda_widget_rtti.h"
 #include "../../MEM/mem_arena.h"
 #include "mda_widget_types.h"
-
-#define MDA_WIDGET_MAX_CHILDREN    16
+#include "mda_widget_constants.h"
+#include <stdbool.h>
 
 typedef struct mda_widget_component_t mda_widget_component_t;
 
@@ -25,6 +25,8 @@ typedef struct { // composite is a component
     mda_widget_component_t component_base;
     mda_widget_component_t* children[MDA_WIDGET_MAX_CHILDREN];
     mda_widget_size_t child_count;
+    mda_widget_rect_t damage[MDA_WIDGET_MAX_DAMAGE];    // only used by the root of the tree
+    uint8_t damage_count;
 } mda_widget_composite_t;
 
 void mda_widget_component_init(
@@ -75,4 +77,13 @@ void mda_widget_composite_add(mda_widget_composite_t* parent, mda_widget_compone
 
 mda_widget_component_t* mda_widget_composite_remove(mda_widget_composite_t* parent, mda_widget_component_t* child);
 
+// record rect (clipped to comp) as damaged on the root composite of comp's tree
+void mda_widget_invalidate(mda_widget_component_t* comp, mda_widget_rect_t rect);
+
+// record the whole of comp as damaged
+void mda_widget_invalidate_all(mda_widget_component_t* comp);
+
+// redraw only the components intersecting the root's damaged rectangles, each clipped to its frame, then clear the damage
+void mda_widget_composite_redraw(mda_widget_composite_t* root);
+
 #endif
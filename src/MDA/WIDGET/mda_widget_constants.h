@@ -3,4 +3,7 @@
 
 #define MDA_WIDGET_MAX_CHILDREN 16
 
+// dirty rectangles held by a root composite before they start being merged together
+#define MDA_WIDGET_MAX_DAMAGE   8
+
 #endif
@@ -10,6 +10,21 @@ typedef uint32_t mda_widget_fingerprint_t;
 
 typedef uint16_t mda_widget_type_t;
 
+typedef enum {
+  MDA_WIDGET_TYPE_COMPONENT,
+  MDA_WIDGET_TYPE_COMPOSITE,
+  MDA_WIDGET_TYPE_PANEL,
+  MDA_WIDGET_TYPE_BORDER,
+  MDA_WIDGET_TYPE_BOARD
+} mda_widget_type_id_t;
+
+typedef struct {      // screen rectangle in absolute character cells
+  uint8_t x;
+  uint8_t y;
+  uint8_t width;
+  uint8_t height;
+} mda_widget_rect_t;
+
 static const unsigned char mda_widget_default_border[6] = {
   CP437_BOX_DOUBLE_DOWN_RIGHT,  // ╔
   CP437_BOX_DOUBLE_DOWN_LEFT,   // ╗
@@ -2,7 +2,12 @@
 #define MDA_CONSTANTS_H
 
 #define MDA_SCREEN_ROWS     25
+#define MDA_SCREEN_COLUMNS  80
 #define MDA_DEFAULT_HTAB    4
 #define MDA_DEFAULT_VTAB    2
 
+// text mode video RAM segments - MDA/Hercules at B000:0000 and CGA/EGA/VGA colour text at B800:0000
+#define MDA_VIDEO_RAM_SEGMENT   0xB000
+#define CGA_VIDEO_RAM_SEGMENT   0xB800
+
 #endif
@@ -2,13 +2,46 @@
 #include "ascii_control_codes.h"
 #include "mda_attributes.h"
 #include "mda_constants.h"
+#include "mda_shadow.h"
+#include "../TDD/tdd_counters.h"
 #include <assert.h>
 
+static uint16_t private_mda_video_segment(mda_context_t* ctx) {
+    return (ctx->video.mode == MDA_TEXT_MONOCHROME_80X25) ? MDA_VIDEO_RAM_SEGMENT : CGA_VIDEO_RAM_SEGMENT;
+}
+
+/**
+ * @brief scroll the context frame by lines (positive up, negative down) blanking with the context attributes
+ * @details Define MDA_BIOS_SCROLL to use INT 10,6/10,7, otherwise video RAM is scrolled directly with overlapping
+ * word moves. Either way the shadow buffer is scrolled to match and nothing in the frame is repainted.
+ */
+static void private_mda_scroll(mda_context_t* ctx, int8_t lines) {
+#ifdef MDA_BIOS_SCROLL
+    uint8_t n = (lines < 0) ? -lines : lines;
+    uint8_t right = ctx->x + ctx->width - 1;
+    uint8_t bottom = ctx->y + ctx->height - 1;
+    if(n >= ctx->height) {
+        n = 0;                              // AL = 0 blanks the whole window
+    }
+    mda_shadow_flush(private_mda_video_segment(ctx));
+    if(lines > 0) {
+        bios_scroll_active_page_up(n, ctx->attributes, ctx->x, ctx->y, right, bottom);
+    }
+    else {
+        bios_scroll_active_page_down(n, ctx->attributes, ctx->x, ctx->y, right, bottom);
+    }
+    mda_shadow_scroll(ctx->x, ctx->y, ctx->width, ctx->height, lines, ' ', ctx->attributes, false);
+#else
+    mda_shadow_scroll_video(private_mda_video_segment(ctx), ctx->x, ctx->y, ctx->width, ctx->height, lines, ' ', ctx->attributes);
+#endif
+}
+
 void mda_initialize_default_context(mda_context_t* ctx) {
     assert(ctx && "NULL context!");
     bios_set_video_mode(MDA_TEXT_MONOCHROME_80X25);
     bios_get_video_state(&ctx->video);
     bios_get_cursor_position_and_size(&ctx->cursor, ctx->video.page);
+    mda_shadow_reset(' ', MDA_NORMAL);  // mode set has just cleared video RAM to the same
     mda_set_context_frame(ctx, 0, 0, ctx->video.columns, MDA_SCREEN_ROWS);
     mda_reset_attributes(ctx);
     ctx->htab_size = MDA_DEFAULT_HTAB;
@@ -29,8 +62,8 @@ void mda_set_context_frame(mda_context_t* ctx, uint8_t x, uint8_t y, uint8_t wid
 void mda_cursor_to(mda_context_t* ctx, uint8_t x, uint8_t y) {
     assert(ctx && "NULL context!");
     assert(mda_context_contains(ctx, x, y) && "OUT OF BOUNDS cursor position!");
-    bios_set_cursor_position(x, y, ctx->video.page);
-    bios_get_cursor_position_and_size(&ctx->cursor, ctx->video.page);
+    ctx->cursor.column = x;     // hardware cursor follows on mda_flush
+    ctx->cursor.row = y;
 }
 
 void mda_set_attributes(mda_context_t* ctx,char attr) {
@@ -48,9 +81,7 @@ void mda_cursor_advance(mda_context_t* ctx) {
     ctx->cursor.column++;
     if(ctx->cursor.column == (ctx->x + ctx->width)) {
         mda_write_CRLF(ctx);
-        return;
     }
-    bios_set_cursor_position(ctx->cursor.column, ctx->cursor.row, ctx->video.page);
 }
 
 void mda_ascii_BEL(mda_context_t* ctx) {
@@ -62,7 +93,6 @@ void mda_ascii_BS(mda_context_t* ctx)  {
     assert(ctx && "NULL context!");
     if(ctx->cursor.column > ctx->x) {
         ctx->cursor.column--;
-        bios_set_cursor_position(ctx->cursor.column, ctx->cursor.row, ctx->video.page);
     }
 }
 
@@ -77,9 +107,9 @@ void mda_ascii_LF(mda_context_t* ctx)  {
     assert(ctx && "NULL context!");
     ctx->cursor.row++;
     if(ctx->cursor.row == (ctx->y + ctx->height)) {
-        ctx->cursor.row = ctx->y;
+        ctx->cursor.row--;
+        mda_scroll_up(ctx, 1);
     }
-    bios_set_cursor_position(ctx->cursor.column, ctx->cursor.row, ctx->video.page);
 }
 
 void mda_ascii_VT(mda_context_t* ctx) {
@@ -91,7 +121,8 @@ void mda_ascii_VT(mda_context_t* ctx) {
 
 void mda_ascii_FF(mda_context_t* ctx) {
     assert(ctx && "NULL context!");
-    //mda_scroll_up(MDA_SCREEN_ROWS);
+    mda_scroll_up(ctx, ctx->height);
+    mda_cursor_to(ctx, ctx->x, ctx->y);
 }
 
 void mda_ascii_CR(mda_context_t* ctx) {
@@ -118,39 +149,149 @@ void mda_write_CRLF(mda_context_t* ctx) {
 
 void mda_write_char(mda_context_t* ctx, char chr) {
     assert(ctx && "NULL context!");
-    bios_write_character_and_attribute_at_cursor(chr, ctx->attributes, 1, ctx->video.page);
+    TDD_COUNT(TDD_COUNTER_MDA_WRITE_CHAR);
+    mda_shadow_put(ctx->cursor.column, ctx->cursor.row, chr, ctx->attributes);
     mda_cursor_advance(ctx);
 }
 
+/**
+ * @brief Moves the cursor down a row, back to the top of the frame after the last
+ * @note Run writers wrap rather than scroll - only LF scrolls, for log panes
+ */
+static void private_mda_next_row(mda_context_t* ctx) {
+    ctx->cursor.row++;
+    if(ctx->cursor.row == (ctx->y + ctx->height)) {
+        ctx->cursor.row = ctx->y;
+    }
+}
+
 void mda_write_string(mda_context_t* ctx, char* stringz) {
     assert(ctx && "NULL context!");
     assert(stringz && "NULL string!");
-    int i = 0;
-    while(stringz[i]) {
-        mda_write_char(ctx, stringz[i++]);
+    while(*stringz) {   // one shadow span per frame line rather than per char
+        uint8_t room = (ctx->x + ctx->width) - ctx->cursor.column;
+        uint8_t n = 0;
+        while(n < room && stringz[n]) {
+            ++n;
+        }
+        mda_shadow_write(ctx->cursor.column, ctx->cursor.row, stringz, n, ctx->attributes);
+        stringz += n;
+        ctx->cursor.column += n;
+        if(ctx->cursor.column == (ctx->x + ctx->width)) {
+            ctx->cursor.column = ctx->x;
+            private_mda_next_row(ctx);
+        }
     }
 }
 
 void mda_write_row(mda_context_t* ctx, char chr, uint16_t count) {
     assert(ctx && "NULL context!");
-    if(!count) {
+    while(count) {
+        uint8_t room = (ctx->x + ctx->width) - ctx->cursor.column;
+        uint8_t n = (count < room) ? count : room;
+        mda_shadow_fill(ctx->cursor.column, ctx->cursor.row, n, chr, ctx->attributes);
+        count -= n;
+        ctx->cursor.column += n;
+        if(ctx->cursor.column == (ctx->x + ctx->width)) {
+            ctx->cursor.column = ctx->x;
+            private_mda_next_row(ctx);
+        }
+    }
+}
+
+void mda_write_column(mda_context_t* ctx, char chr, uint16_t count) {
+    assert(ctx && "NULL context!");
+    while(count) {
+        uint8_t room = (ctx->y + ctx->height) - ctx->cursor.row;
+        uint8_t n = (count < room) ? count : room;
+        mda_shadow_fill_column(ctx->cursor.column, ctx->cursor.row, n, chr, ctx->attributes);
+        count -= n;
+        ctx->cursor.row += n - 1;
+        private_mda_next_row(ctx);
+    }
+}
+
+uint8_t mda_write_span(mda_context_t* ctx, uint8_t x, uint8_t y, const char* stringz) {
+    assert(ctx && "NULL context!");
+    assert(stringz && "NULL string!");
+    uint8_t right = ctx->x + ctx->width;
+    if(y < ctx->y || y >= (ctx->y + ctx->height) || x >= right) {
+        return 0;
+    }
+    while(x < ctx->x && *stringz) {    // clip on the left
+        ++x;
+        ++stringz;
+    }
+    uint8_t n = 0;
+    while(x + n < right && stringz[n]) {  // clip on the right
+        ++n;
+    }
+    mda_shadow_write(x, y, stringz, n, ctx->attributes);
+    return n;
+}
+
+void mda_fill_rect(mda_context_t* ctx, uint8_t x, uint8_t y, uint8_t width, uint8_t height, char chr) {
+    assert(ctx && "NULL context!");
+    uint16_t left = (x > ctx->x) ? x : ctx->x;
+    uint16_t top = (y > ctx->y) ? y : ctx->y;
+    uint16_t right = x + width;
+    uint16_t bottom = y + height;
+    if(right > (uint16_t)(ctx->x + ctx->width)) {
+        right = ctx->x + ctx->width;
+    }
+    if(bottom > (uint16_t)(ctx->y + ctx->height)) {
+        bottom = ctx->y + ctx->height;
+    }
+    if(left >= right || top >= bottom) {
         return;
     }
-    for(int i = 0; i < count; ++i) {
-        mda_write_char(ctx, chr);
+    for(uint16_t row = top; row < bottom; ++row) {
+        mda_shadow_fill(left, row, right - left, chr, ctx->attributes);
     }
 }
 
-void mda_write_column(mda_context_t* ctx, char chr, uint16_t count) {
+void mda_write_vrun(mda_context_t* ctx, uint8_t x, uint8_t y, char chr, uint8_t count) {
     assert(ctx && "NULL context!");
-    if(!count) {
+    if(x < ctx->x || x >= (ctx->x + ctx->width)) {
         return;
     }
-    for(int i = 0; i < count; ++i) {
-        bios_write_character_and_attribute_at_cursor(chr, ctx->attributes, 1, ctx->video.page);
-        mda_ascii_LF(ctx);
+    uint16_t top = (y > ctx->y) ? y : ctx->y;
+    uint16_t bottom = y + count;
+    if(bottom > (uint16_t)(ctx->y + ctx->height)) {
+        bottom = ctx->y + ctx->height;
+    }
+    if(top >= bottom) {
+        return;
+    }
+    mda_shadow_fill_column(x, top, bottom - top, chr, ctx->attributes);
+}
+
+void mda_flush(mda_context_t* ctx) {
+    assert(ctx && "NULL context!");
+    mda_shadow_flush(private_mda_video_segment(ctx));
+    bios_set_cursor_position(ctx->cursor.column, ctx->cursor.row, ctx->video.page);
+}
+
+void mda_scroll_up(mda_context_t* ctx, uint8_t lines) {
+    assert(ctx && "NULL context!");
+    if(!lines) {
+        return;
+    }
+    if(lines > ctx->height) {
+        lines = ctx->height;
+    }
+    private_mda_scroll(ctx, (int8_t)lines);
+}
 
+void mda_scroll_down(mda_context_t* ctx, uint8_t lines) {
+    assert(ctx && "NULL context!");
+    if(!lines) {
+        return;
+    }
+    if(lines > ctx->height) {
+        lines = ctx->height;
     }
+    private_mda_scroll(ctx, -(int8_t)lines);
 }
 
 bool mda_context_contains(mda_context_t*ctx, uint8_t x, uint8_t y) {
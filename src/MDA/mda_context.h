@@ -65,6 +65,25 @@ void mda_write_row(mda_context_t* ctx, char chr, uint16_t count);
 
 void mda_write_column(mda_context_t* ctx, char chr, uint16_t count);
 
+// span primitives - absolute screen coordinates, clipped to the context frame, cursor is *not* moved
+
+// write stringz from x,y in one pass returns the number of characters written
+uint8_t mda_write_span(mda_context_t* ctx, uint8_t x, uint8_t y, const char* stringz);
+
+// fill a rectangle with one char/attr word (rep stosw per row)
+void mda_fill_rect(mda_context_t* ctx, uint8_t x, uint8_t y, uint8_t width, uint8_t height, char chr);
+
+// vertical run of count cells downward from x,y (stosw with a row stride)
+void mda_write_vrun(mda_context_t* ctx, uint8_t x, uint8_t y, char chr, uint8_t count);
+
+// scroll the context frame, blank lines take the context attributes - cheaper than repainting the frame
+void mda_scroll_up(mda_context_t* ctx, uint8_t lines);
+
+void mda_scroll_down(mda_context_t* ctx, uint8_t lines);
+
+// copy the dirty spans of the shared shadow buffer to video RAM and place the hardware cursor
+void mda_flush(mda_context_t* ctx);
+
 bool mda_context_contains(mda_context_t* ctx, uint8_t x, uint8_t y);
 
 #endif
@@ -0,0 +1,262 @@
+#include "mda_shadow.h"
+#include <assert.h>
+
+/**
+ * @brief the one and only shadow screen shared by every context
+ * @note 4000 bytes of cells + dirty bookkeeping - dirty_first/dirty_last are only meaningful when the row bit is set
+ */
+struct mda_shadow_t {
+    mda_char_attr_t cells[MDA_SCREEN_ROWS][MDA_SCREEN_COLUMNS];
+    uint32_t dirty_rows;                    // bit y set if row y has a dirty span (25 rows fit a dword)
+    uint8_t dirty_first[MDA_SCREEN_ROWS];
+    uint8_t dirty_last[MDA_SCREEN_ROWS];
+};
+
+static struct mda_shadow_t shadow;
+
+void mda_shadow_reset(char chr, char attr) {
+    mda_char_attr_t fill;
+    fill.parts.chr = chr;
+    fill.parts.attr = attr;
+    for(uint8_t y = 0; y < MDA_SCREEN_ROWS; ++y) {
+        for(uint8_t x = 0; x < MDA_SCREEN_COLUMNS; ++x) {
+            shadow.cells[y][x] = fill;
+        }
+    }
+    shadow.dirty_rows = 0;
+}
+
+void mda_shadow_mark_dirty(uint8_t x, uint8_t y, uint8_t count) {
+    assert(x < MDA_SCREEN_COLUMNS && "OUT OF RANGE x value!");
+    assert(y < MDA_SCREEN_ROWS && "OUT OF RANGE y value!");
+    assert(count && x + count <= MDA_SCREEN_COLUMNS && "OUT OF RANGE span!");
+    uint8_t last = x + count - 1;
+    uint32_t bit = 1UL << y;
+    if(shadow.dirty_rows & bit) {       // widen the existing span
+        if(x < shadow.dirty_first[y]) {
+            shadow.dirty_first[y] = x;
+        }
+        if(last > shadow.dirty_last[y]) {
+            shadow.dirty_last[y] = last;
+        }
+        return;
+    }
+    shadow.dirty_rows |= bit;
+    shadow.dirty_first[y] = x;
+    shadow.dirty_last[y] = last;
+}
+
+void mda_shadow_put(uint8_t x, uint8_t y, char chr, char attr) {
+    assert(x < MDA_SCREEN_COLUMNS && "OUT OF RANGE x value!");
+    assert(y < MDA_SCREEN_ROWS && "OUT OF RANGE y value!");
+    mda_char_attr_t* cell = &shadow.cells[y][x];
+    if(cell->parts.chr == chr && cell->parts.attr == attr) {
+        return;                         // unchanged cells cost no video RAM traffic
+    }
+    cell->parts.chr = chr;
+    cell->parts.attr = attr;
+    mda_shadow_mark_dirty(x, y, 1);
+}
+
+/**
+ * @brief rep stosw count copies of one char/attr word from cell onward
+ */
+static void private_mda_fill_words(mda_char_attr_t* cell, uint16_t count, char chr, char attr) {
+    __asm {
+        .8086
+        pushf
+
+        les     di, cell                ; ES:DI = first cell
+        mov     al, chr
+        mov     ah, attr                ; AX = char/attr word
+        mov     cx, count
+        cld
+        rep     stosw
+
+        popf
+    }
+}
+
+/**
+ * @brief rep movsw count char/attr words from src to dst - both in the same segment ie the same screen
+ */
+static void private_mda_move_words(mda_char_attr_t* dst, mda_char_attr_t* src, uint16_t count) {
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        les     di, dst                 ; ES:DI = destination row
+        mov     cx, count
+        lds     si, src                 ; DS:SI = source row
+        cld
+        rep     movsw
+
+        pop     ds
+        popf
+    }
+}
+
+/**
+ * @brief Scrolls a rectangle of an 80 column screen (shadow or video RAM) by word moves, blanking the vacated rows
+ * @note rows are visited in the order that never overwrites a source row before it has been moved
+ */
+static void private_mda_scroll_screen(mda_char_attr_t* screen, uint8_t x, uint8_t y, uint8_t width, uint8_t height, int8_t lines, char chr, char attr) {
+    uint8_t n = (lines < 0) ? -lines : lines;
+    if(n > height) {
+        n = height;
+    }
+    uint8_t moved = height - n;
+    if(lines > 0) {             // up - top row first
+        for(uint8_t r = 0; r < moved; ++r) {
+            private_mda_move_words(screen + (y + r) * MDA_SCREEN_COLUMNS + x, screen + (y + r + n) * MDA_SCREEN_COLUMNS + x, width);
+        }
+        for(uint8_t r = moved; r < height; ++r) {
+            private_mda_fill_words(screen + (y + r) * MDA_SCREEN_COLUMNS + x, width, chr, attr);
+        }
+    }
+    else {                      // down - bottom row first
+        for(uint8_t r = height; r > n; --r) {
+            private_mda_move_words(screen + (y + r - 1) * MDA_SCREEN_COLUMNS + x, screen + (y + r - 1 - n) * MDA_SCREEN_COLUMNS + x, width);
+        }
+        for(uint8_t r = 0; r < n; ++r) {
+            private_mda_fill_words(screen + (y + r) * MDA_SCREEN_COLUMNS + x, width, chr, attr);
+        }
+    }
+}
+
+void mda_shadow_fill(uint8_t x, uint8_t y, uint8_t count, char chr, char attr) {
+    if(!count) {
+        return;
+    }
+    mda_shadow_mark_dirty(x, y, count);     // asserts the span is on screen
+    private_mda_fill_words(&shadow.cells[y][x], count, chr, attr);
+}
+
+void mda_shadow_write(uint8_t x, uint8_t y, const char* chars, uint8_t count, char attr) {
+    assert(chars && "NULL characters!");
+    if(!count) {
+        return;
+    }
+    mda_shadow_mark_dirty(x, y, count);
+    mda_char_attr_t* cell = &shadow.cells[y][x];
+    uint16_t n = count;
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        les     di, cell                ; ES:DI = first shadow cell
+        mov     ah, attr
+        mov     cx, n
+        lds     si, chars               ; DS:SI = characters
+        cld
+NEXT:   lodsb                           ; AL = next char
+        stosw                           ; store char/attr
+        loop    NEXT
+
+        pop     ds
+        popf
+    }
+}
+
+void mda_shadow_fill_column(uint8_t x, uint8_t y, uint8_t count, char chr, char attr) {
+    if(!count) {
+        return;
+    }
+    assert(y + count <= MDA_SCREEN_ROWS && "OUT OF RANGE column run!");
+    for(uint8_t row = y; row < y + count; ++row) {
+        mda_shadow_mark_dirty(x, row, 1);
+    }
+    mda_char_attr_t* cell = &shadow.cells[y][x];
+    uint16_t n = count;
+    uint16_t stride = (MDA_SCREEN_COLUMNS - 1) * sizeof(mda_char_attr_t);  // stosw has already stepped one cell
+    __asm {
+        .8086
+        pushf
+
+        les     di, cell                ; ES:DI = top shadow cell
+        mov     al, chr
+        mov     ah, attr
+        mov     cx, n
+        mov     dx, stride
+        cld
+DOWN:   stosw
+        add     di, dx                  ; next row same column
+        loop    DOWN
+
+        popf
+    }
+}
+
+void mda_shadow_scroll(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int8_t lines, char chr, char attr, bool mark_dirty) {
+    assert(x + width <= MDA_SCREEN_COLUMNS && y + height <= MDA_SCREEN_ROWS && "OUT OF RANGE scroll window!");
+    if(!width || !height || !lines) {
+        return;
+    }
+    private_mda_scroll_screen(&shadow.cells[0][0], x, y, width, height, lines, chr, attr);
+    if(mark_dirty) {
+        for(uint8_t r = y; r < y + height; ++r) {
+            mda_shadow_mark_dirty(x, r, width);
+        }
+    }
+}
+
+void mda_shadow_scroll_video(uint16_t video_segment, uint8_t x, uint8_t y, uint8_t width, uint8_t height, int8_t lines, char chr, char attr) {
+    assert(x + width <= MDA_SCREEN_COLUMNS && y + height <= MDA_SCREEN_ROWS && "OUT OF RANGE scroll window!");
+    if(!width || !height || !lines) {
+        return;
+    }
+    mda_char_attr_t* video = (mda_char_attr_t*)((uint32_t)video_segment << 16);
+    mda_shadow_flush(video_segment);    // video RAM must match before it is moved
+    private_mda_scroll_screen(video, x, y, width, height, lines, chr, attr);
+    private_mda_scroll_screen(&shadow.cells[0][0], x, y, width, height, lines, chr, attr);
+}
+
+mda_char_attr_t mda_shadow_get(uint8_t x, uint8_t y) {
+    assert(x < MDA_SCREEN_COLUMNS && "OUT OF RANGE x value!");
+    assert(y < MDA_SCREEN_ROWS && "OUT OF RANGE y value!");
+    return shadow.cells[y][x];
+}
+
+mda_char_attr_t* mda_shadow_row(uint8_t y) {
+    assert(y < MDA_SCREEN_ROWS && "OUT OF RANGE y value!");
+    return shadow.cells[y];
+}
+
+bool mda_shadow_is_row_dirty(uint8_t y) {
+    assert(y < MDA_SCREEN_ROWS && "OUT OF RANGE y value!");
+    return (shadow.dirty_rows & (1UL << y)) != 0;
+}
+
+void mda_shadow_flush(uint16_t video_segment) {
+    if(!shadow.dirty_rows) {
+        return;
+    }
+    for(uint8_t y = 0; y < MDA_SCREEN_ROWS; ++y) {
+        if(!(shadow.dirty_rows & (1UL << y))) {
+            continue;
+        }
+        uint8_t first = shadow.dirty_first[y];
+        uint16_t count = shadow.dirty_last[y] - first + 1;
+        uint16_t vram_offset = (y * MDA_SCREEN_COLUMNS + first) * sizeof(mda_char_attr_t);
+        mda_char_attr_t* span = &shadow.cells[y][first];
+        __asm {
+            .8086
+            pushf
+            push    ds
+
+            mov     ax, video_segment
+            mov     es, ax
+            mov     di, vram_offset         ; ES:DI = video RAM cell
+            mov     cx, count               ; words to copy
+            lds     si, span                ; DS:SI = shadow cell
+            cld
+            rep     movsw                   ; char/attr pairs in one pass
+
+            pop     ds
+            popf
+        }
+    }
+    shadow.dirty_rows = 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file mda_shadow.h
+ * @brief Off-screen 80x25 shadow (back) buffer with per-row dirty tracking
+ * @details All mda_context writes land in the shadow buffer and only the dirty spans are copied to
+ * video RAM when mda_shadow_flush() is called, so widgets can redraw freely while the (slow, and on CGA
+ * snow-prone) video memory traffic is limited to what actually changed.
+ */
+#ifndef MDA_SHADOW_H
+#define MDA_SHADOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mda_constants.h"
+#include "mda_types.h"
+
+/**
+ * @brief Resets every shadow cell to fill and marks the buffer clean
+ * @note Use after a video mode set, when video RAM is already known to hold the same fill
+ */
+void mda_shadow_reset(char chr, char attr);
+
+/**
+ * @brief Writes one char/attr cell and marks its span dirty
+ */
+void mda_shadow_put(uint8_t x, uint8_t y, char chr, char attr);
+
+/**
+ * @brief Reads one char/attr cell from the shadow buffer (no video RAM access)
+ */
+mda_char_attr_t mda_shadow_get(uint8_t x, uint8_t y);
+
+/**
+ * @brief Pointer to the first cell of row y - for span writers that mark their own dirty range
+ */
+mda_char_attr_t* mda_shadow_row(uint8_t y);
+
+/**
+ * @brief Widens the dirty span of row y to include columns [x, x + count)
+ */
+void mda_shadow_mark_dirty(uint8_t x, uint8_t y, uint8_t count);
+
+/**
+ * @brief Fills count cells of row y from column x with one char/attr word (rep stosw)
+ */
+void mda_shadow_fill(uint8_t x, uint8_t y, uint8_t count, char chr, char attr);
+
+/**
+ * @brief Copies count characters into row y from column x, all with the same attribute (lodsb/stosw)
+ */
+void mda_shadow_write(uint8_t x, uint8_t y, const char* chars, uint8_t count, char attr);
+
+/**
+ * @brief Fills count cells of column x downward from row y (stosw with a row stride)
+ */
+void mda_shadow_fill_column(uint8_t x, uint8_t y, uint8_t count, char chr, char attr);
+
+/**
+ * @brief Scrolls a window of the shadow buffer by lines (positive up, negative down) blanking vacated rows with chr/attr
+ * @param mark_dirty true to repaint the window on the next flush, false when video RAM has already been scrolled to match
+ */
+void mda_shadow_scroll(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int8_t lines, char chr, char attr, bool mark_dirty);
+
+/**
+ * @brief Flushes, then scrolls the same window in both video RAM and the shadow with overlapping word moves
+ * @note leaves the window clean - only the moved words touch video RAM, nothing is repainted
+ */
+void mda_shadow_scroll_video(uint16_t video_segment, uint8_t x, uint8_t y, uint8_t width, uint8_t height, int8_t lines, char chr, char attr);
+
+/**
+ * @brief Is any part of row y waiting to be flushed?
+ */
+bool mda_shadow_is_row_dirty(uint8_t y);
+
+/**
+ * @brief Copies only the dirty spans to video RAM with rep movsw and marks the buffer clean
+ * @param video_segment eg MDA_VIDEO_RAM_SEGMENT
+ */
+void mda_shadow_flush(uint16_t video_segment);
+
+#endif
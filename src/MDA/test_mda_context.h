@@ -5,10 +5,20 @@
 #include "mda_attributes.h"
 #include "mda_types.h"
 #include "mda_constants.h"
+#include "mda_shadow.h"
 #include "WIDGET/mda_widget_composite.h"
+#include "WIDGET/mda_widget_board.h"
+#include "WIDGET/mda_widget_border.h"
+#include "../CHESS/xt_position.h"
 #include <stdio.h>
 
-#define MDA_CONTEXT_TESTS &mda_context_test \
+#define MDA_CONTEXT_TESTS &mda_context_test, \
+    &mda_shadow_test, \
+    &mda_span_test, \
+    &mda_scroll_test, \
+    &mda_widget_board_test, \
+    &mda_widget_damage_test, \
+    &mda_widget_border_test
 
 TEST(mda_context_test) {
     mda_context_t ctx;
@@ -54,14 +64,215 @@ TEST(mda_context_test) {
     mda_write_column(&ctx, CP437_DOWN_ARROW, 20);
 
     mda_ascii_BEL(&ctx);
+    mda_flush(&ctx);
 
     getchar();
 }
 
+TEST(mda_shadow_test) {
+    mda_context_t ctx;
+    mda_char_attr_t cell;
+    mda_initialize_default_context(&ctx);
+    for(uint8_t y = 0; y < MDA_SCREEN_ROWS; ++y) {
+        EXPECT_FALSE(mda_shadow_is_row_dirty(y));
+    }
+    mda_cursor_to(&ctx, 5, 3);
+    mda_write_string(&ctx, "shadow");
+        EXPECT_TRUE(mda_shadow_is_row_dirty(3));
+        EXPECT_FALSE(mda_shadow_is_row_dirty(2));
+        EXPECT_FALSE(mda_shadow_is_row_dirty(4));
+    cell = mda_shadow_get(5, 3);
+        EXPECT_EQ(cell.parts.chr, 's');
+        EXPECT_EQ(cell.parts.attr, MDA_NORMAL);
+    mda_flush(&ctx);
+        EXPECT_FALSE(mda_shadow_is_row_dirty(3));
+    mda_cursor_to(&ctx, 0, 3);
+    mda_set_attributes(&ctx, MDA_REVERSE);
+    mda_write_char(&ctx, ' ');     // attribute change alone must dirty the cell
+        EXPECT_TRUE(mda_shadow_is_row_dirty(3));
+    mda_flush(&ctx);
+    mda_cursor_to(&ctx, 0, 3);
+    mda_write_char(&ctx, ' ');     // identical cell is not re-flushed
+        EXPECT_FALSE(mda_shadow_is_row_dirty(3));
+    bios_set_cursor_position(5, 3, ctx.video.page);
+    cell.char_attr = bios_read_character_and_attribute_at_cursor(ctx.video.page);
+        EXPECT_EQ(cell.parts.chr, 's');
+}
+
+TEST(mda_span_test) {
+    mda_context_t ctx;
+    mda_char_attr_t cell;
+    mda_initialize_default_context(&ctx);
+    mda_set_context_frame(&ctx, 10, 5, 20, 5);
+    EXPECT_EQ(mda_write_span(&ctx, 8, 5, "abcdef"), 4);    // clipped on the left
+    cell = mda_shadow_get(10, 5);
+        EXPECT_EQ(cell.parts.chr, 'c');
+    cell = mda_shadow_get(9, 5);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    EXPECT_EQ(mda_write_span(&ctx, 27, 6, "abcdef"), 3);   // clipped on the right
+    cell = mda_shadow_get(30, 6);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    EXPECT_EQ(mda_write_span(&ctx, 12, 4, "abcdef"), 0);   // above the frame
+    mda_set_attributes(&ctx, MDA_REVERSE);
+    mda_fill_rect(&ctx, 25, 8, 10, 10, '#');               // clipped to 5x2
+    cell = mda_shadow_get(29, 9);
+        EXPECT_EQ(cell.parts.chr, '#');
+        EXPECT_EQ(cell.parts.attr, MDA_REVERSE);
+    cell = mda_shadow_get(30, 9);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    cell = mda_shadow_get(29, 10);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    mda_write_vrun(&ctx, 11, 3, '|', 20);                  // clipped to rows 5..9
+    cell = mda_shadow_get(11, 9);
+        EXPECT_EQ(cell.parts.chr, '|');
+    cell = mda_shadow_get(11, 4);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    mda_cursor_to(&ctx, 28, 7);
+    mda_write_string(&ctx, "wrap");                         // legacy writers still wrap at the frame
+    cell = mda_shadow_get(10, 8);
+        EXPECT_EQ(cell.parts.chr, 'a');
+        EXPECT_EQ(ctx.cursor.column, 12);
+        EXPECT_EQ(ctx.cursor.row, 8);
+    mda_flush(&ctx);
+}
+
+TEST(mda_scroll_test) {
+    mda_context_t ctx;
+    mda_char_attr_t cell;
+    mda_initialize_default_context(&ctx);
+    mda_set_context_frame(&ctx, 20, 10, 10, 3);
+    mda_write_span(&ctx, 20, 10, "line 0");
+    mda_write_span(&ctx, 20, 11, "line 1");
+    mda_write_span(&ctx, 20, 12, "line 2");
+    mda_write_span(&ctx, 19, 10, "|outside");              // clipped so column 19 stays blank
+    mda_scroll_up(&ctx, 1);
+        EXPECT_FALSE(mda_shadow_is_row_dirty(10));          // video RAM was scrolled, nothing to repaint
+    cell = mda_shadow_get(25, 10);
+        EXPECT_EQ(cell.parts.chr, '1');
+    cell = mda_shadow_get(25, 12);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    bios_set_cursor_position(25, 11, ctx.video.page);
+    cell.char_attr = bios_read_character_and_attribute_at_cursor(ctx.video.page);
+        EXPECT_EQ(cell.parts.chr, '2');
+    mda_scroll_down(&ctx, 2);
+    cell = mda_shadow_get(25, 12);
+        EXPECT_EQ(cell.parts.chr, '1');
+    cell = mda_shadow_get(25, 10);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    mda_cursor_to(&ctx, 20, 12);
+    mda_ascii_LF(&ctx);                                     // LF on the last row scrolls rather than wraps
+        EXPECT_EQ(ctx.cursor.row, 12);
+    cell = mda_shadow_get(25, 11);
+        EXPECT_EQ(cell.parts.chr, '1');
+    mda_ascii_FF(&ctx);
+        EXPECT_EQ(ctx.cursor.row, 10);
+    cell = mda_shadow_get(25, 11);
+        EXPECT_EQ(cell.parts.chr, ' ');
+    mda_write_column(&ctx, '#', 3);                         // run writers wrap to the top, never scroll
+        EXPECT_EQ(ctx.cursor.row, 10);
+    cell = mda_shadow_get(20, 10);
+        EXPECT_EQ(cell.parts.chr, '#');
+    cell = mda_shadow_get(20, 12);
+        EXPECT_EQ(cell.parts.chr, '#');
+}
+
 TEST(mda_widgets_test) {
     mda_context_t ctx;
     mda_initialize_default_context(&ctx);
 
 }
 
+TEST(mda_widget_board_test) {
+    mda_context_t ctx;
+    mda_widget_board_t board;
+    xt_position_t position;
+    mda_char_attr_t cell;
+    mda_initialize_default_context(&ctx);
+    mda_widget_board_init(&board, NULL, &ctx, 2, 2);
+    xt_position_initial(&position);
+        EXPECT_EQ(mda_widget_board_update(&board, &position), 64);     // first update paints the lot
+    cell = mda_shadow_get(2 + 4 * MDA_WIDGET_BOARD_SQUARE_WIDTH + 1, 2 + 7);   // e1
+        EXPECT_EQ(cell.parts.chr, 'K');
+    cell = mda_shadow_get(2 + 1, 2 + 7);                                     // a1 dark
+        EXPECT_EQ(cell.parts.attr, MDA_NORMAL);
+    mda_flush(&ctx);
+    xt_position_move(&position, 12, 28);                                     // e2-e4
+        EXPECT_EQ(mda_widget_board_update(&board, &position), 2);
+    cell = mda_shadow_get(2 + 4 * MDA_WIDGET_BOARD_SQUARE_WIDTH + 1, 2 + 4); // e4
+        EXPECT_EQ(cell.parts.chr, 'P');
+    cell = mda_shadow_get(2 + 4 * MDA_WIDGET_BOARD_SQUARE_WIDTH + 1, 2 + 6); // e2
+        EXPECT_EQ(cell.parts.chr, ' ');
+        EXPECT_EQ(cell.parts.attr, MDA_REVERSE);
+        EXPECT_FALSE(mda_shadow_is_row_dirty(2 + 7));                        // rank 1 untouched
+        EXPECT_EQ(mda_widget_board_update(&board, &position), 0);          // nothing changed, nothing painted
+    mda_flush(&ctx);
+}
+
+static uint8_t mda_widget_draw_count = 0;
+
+static void mda_widget_count_draw(mda_widget_component_t* comp) {
+    mda_widget_draw_count++;
+    mda_fill_rect(comp->ctx, comp->ctx->x, comp->ctx->y, comp->ctx->width, comp->ctx->height, '#');
+}
+
+TEST(mda_widget_damage_test) {
+    mda_context_t ctx;
+    mda_widget_composite_t root;
+    mda_widget_component_t left;
+    mda_widget_component_t right;
+    mda_widget_rect_t rect = { 2, 2, 3, 3 };
+    mda_initialize_default_context(&ctx);
+    mda_widget_composite_init(MDA_WIDGET_TYPE_COMPOSITE, &root, NULL, &ctx, 0, 0, 80, 25);
+    mda_widget_component_init(MDA_WIDGET_TYPE_COMPONENT, &left, NULL, &ctx, 0, 0, 10, 5);
+    mda_widget_component_init(MDA_WIDGET_TYPE_COMPONENT, &right, NULL, &ctx, 40, 0, 10, 5);
+    left.draw = mda_widget_count_draw;
+    right.draw = mda_widget_count_draw;
+    mda_widget_composite_add(&root, &left);
+    mda_widget_composite_add(&root, &right);
+    mda_widget_composite_redraw(&root);
+        EXPECT_EQ(mda_widget_draw_count, 0);    // nothing damaged, nothing drawn
+    mda_widget_invalidate(&left, rect);
+    mda_widget_invalidate(&left, rect);         // covered rectangles are not queued twice
+        EXPECT_EQ(root.damage_count, 1);
+    mda_widget_composite_redraw(&root);
+        EXPECT_EQ(mda_widget_draw_count, 1);    // right does not intersect
+        EXPECT_EQ(root.damage_count, 0);
+        EXPECT_EQ(mda_shadow_get(9, 4).parts.chr, '#');
+        EXPECT_EQ(mda_shadow_get(10, 4).parts.chr, ' ');  // clipped to the frame
+        EXPECT_EQ(ctx.width, 80);               // frame restored after the pass
+    mda_widget_invalidate_all(&right);
+    mda_widget_invalidate_all(&left);
+    mda_widget_composite_redraw(&root);
+        EXPECT_EQ(mda_widget_draw_count, 3);
+    for(uint8_t i = 0; i < MDA_WIDGET_MAX_DAMAGE + 2; ++i) {
+        rect.x = i * 8;
+        rect.y = 20;
+        rect.width = 1;
+        rect.height = 1;
+        mda_widget_invalidate(&root.component_base, rect);
+    }
+        EXPECT_EQ(root.damage_count, MDA_WIDGET_MAX_DAMAGE);  // overflow merges
+    mda_widget_composite_redraw(&root);
+        EXPECT_EQ(mda_widget_draw_count, 3);    // damage below both children
+}
+
+TEST(mda_widget_border_test) {
+    mda_context_t ctx;
+    mda_widget_composite_t root;
+    mda_widget_border_t border;
+    char box[] = "+++" "+-|";                   // corners, horizontal, vertical
+    mda_initialize_default_context(&ctx);
+    mda_widget_composite_init(MDA_WIDGET_TYPE_COMPOSITE, &root, NULL, &ctx, 0, 0, 80, 25);
+    mda_widget_border_init(&border, &root.component_base, 10, 5, 6, 4, box, true);
+        EXPECT_EQ(ctx.x, 11);                   // context shrunk inside the border
+        EXPECT_EQ(ctx.height, 2);
+    mda_widget_composite_add(&root, &border.base);
+    mda_widget_invalidate_all(&border.base);
+    mda_widget_composite_redraw(&root);
+        EXPECT_EQ(mda_shadow_get(10, 5).parts.chr, '+');
+        EXPECT_EQ(mda_shadow_get(12, 8).parts.chr, '-');
+        EXPECT_EQ(mda_shadow_get(15, 6).parts.chr, '|');
+        EXPECT_EQ(mda_shadow_get(12, 6).parts.chr, ' ');  // inside left alone
+}
+
 #endif
@@ -8,11 +8,13 @@
 #include <stdio.h>
 #include <assert.h>
 #include <memory.h>
+#include <string.h>
 
 #include "mem_arena.h"
 
 #include "../DOS/dos_services.h"
 #include "mem_constants.h"
+#include "mem_ems.h"
 #include "mem_tools.h"
 #include "mem_types.h"
 
@@ -33,18 +35,52 @@
  * @enddot
  */
 typedef struct private_mem_arena_t {
-    uint8_t policy;         ///< MEM_ARENA_POLICY_DOS or MEM_ARENA_POLICY_C
+    uint8_t policy;         ///< mem_arena_policy_t e.g. MEM_ARENA_POLICY_DOS
     mem_address_t start;    ///< Base address of allocated memory
     char* free;             ///< Current allocation pointer
     char* end;              ///< End of available memory
+    mem_size_t retired;     ///< Capacity of the earlier blocks of a chained arena
+    uint16_t ems_handle;    ///< Expanded memory handle of an EMS arena
+#ifdef MEM_ARENA_STATS
+    mem_arena_stats_t stats;    ///< Instrumentation
+#endif
 } mem_arena_t;
 
 /// Default-initialized DOS arena template
 static const mem_arena_t default_dos_mem_arena_t = {
     MEM_ARENA_POLICY_DOS,
-    {NULL}, NULL, NULL
+    {NULL}, NULL, NULL, 0, 0
 };
 
+/* ----------------- Instrumentation ----------------- */
+
+#ifdef MEM_ARENA_STATS
+/**
+ * @brief Adds an allocation to the totals of its tag
+ * @details Tags are matched by pointer first (string literals) then by content
+ */
+static void private_mem_arena_stats_tag(mem_arena_t* arena, const char* tag, mem_size_t byte_request) {
+    mem_arena_stats_t* stats = &arena->stats;
+    uint8_t i;
+    for (i = 0; i < stats->tag_count; ++i) {
+        if (stats->tags[i].tag == tag || strcmp(stats->tags[i].tag, tag) == 0) {
+            break;
+        }
+    }
+    if (i == stats->tag_count) {
+        if (stats->tag_count == MEM_ARENA_MAX_TAGS) {
+            return;
+        }
+        stats->tags[stats->tag_count].tag = tag;
+        stats->tags[stats->tag_count].bytes = 0;
+        stats->tags[stats->tag_count].count = 0;
+        ++stats->tag_count;
+    }
+    stats->tags[i].bytes += byte_request;
+    ++stats->tags[i].count;
+}
+#endif
+
 /* ----------------- DOS-Specific Implementation ----------------- */
 
 /**
@@ -105,6 +141,274 @@ mem_size_t private_mem_arena_dos_delete(mem_arena_t* arena) {
     return freed;
 }
 
+/* ----------------- Huge-Specific Implementation ----------------- */
+
+/**
+ * @brief Creates a huge DOS memory arena via INT 21h
+ * @param byte_count Requested size in bytes (may exceed 64KB)
+ * @return Initialized arena or NULL on failure
+ *
+ * @details start, free and end are all normalized far pointers, so the arena
+ *          is addressed linearly and released like any DOS arena
+ */
+mem_arena_t* private_mem_arena_huge_new(mem_size_t byte_count) {
+    mem_arena_t* arena = private_mem_arena_dos_new(byte_count);
+    if (arena) {
+        arena->policy = MEM_ARENA_POLICY_HUGE;
+        if (arena->start.segoff.segment) {
+            mem_size_t paragraphs = (byte_count / MEM_SIZE_PARAGRAPH) + ((byte_count % MEM_SIZE_PARAGRAPH) ? 1 : 0);
+            arena->end = (char*)mem_linear_to_pointer(mem_linear_address(arena->start.ptr) + (paragraphs * MEM_SIZE_PARAGRAPH));
+        }
+    }
+    return arena;
+}
+
+/**
+ * @brief Moves the free pointer keeping huge arenas normalized
+ * @param arena Valid arena
+ * @param delta Signed byte count
+ */
+static void private_mem_arena_bump(mem_arena_t* arena, mem_diff_t delta) {
+    if (arena->policy == MEM_ARENA_POLICY_HUGE) {
+        arena->free = (char*)mem_linear_to_pointer(mem_linear_address(arena->free) + delta);
+    }
+    else if (arena->policy == MEM_ARENA_POLICY_EMS) {
+        mem_address_t logical;
+        logical.ptr = arena->free;
+        logical.memloc += delta;
+        arena->free = logical.ptr;
+    }
+    else {
+        arena->free += delta;
+    }
+}
+
+/* ----------------- Chained-Specific Implementation ----------------- */
+
+/**
+ * @brief Header in the first paragraph of every chained block
+ * @dot
+ * digraph chain {
+ *     rankdir=LR;
+ *     node [shape=record, fontname="Courier New"];
+ *     b2 [label="<h> prev|paragraphs|usable..."];
+ *     b1 [label="<h> prev (0)|paragraphs|usable..."];
+ *     b2:h -> b1:h;
+ * }
+ * @enddot
+ */
+typedef struct {
+    uint16_t prev_segment;  ///< Previous block or 0 for the first
+    uint16_t paragraphs;    ///< Block size including this header
+} mem_arena_chain_header_t;
+
+/**
+ * @brief Gets the header of the current chained block
+ */
+static mem_arena_chain_header_t* private_mem_arena_chain_header(mem_arena_t* arena) {
+    mem_address_t header = arena->start;
+    header.segoff.offset = 0;
+    return (mem_arena_chain_header_t*)header.ptr;
+}
+
+/**
+ * @brief Allocates a DOS block and makes it the current block
+ * @param arena Chained arena
+ * @param paragraphs Block size including the header paragraph
+ * @return 1 on success, 0 if DOS is out of memory
+ */
+static int private_mem_arena_chain_link(mem_arena_t* arena, uint16_t paragraphs) {
+    uint16_t segment = dos_allocate_memory_blocks(paragraphs);
+    if (!segment) {
+        return 0;
+    }
+    mem_address_t block;
+    block.segoff.segment = segment;
+    block.segoff.offset = 0;
+    mem_arena_chain_header_t* header = (mem_arena_chain_header_t*)block.ptr;
+    header->prev_segment = arena->start.segoff.segment;
+    header->paragraphs = paragraphs;
+    if (arena->start.segoff.segment) {
+        arena->retired += mem_diff_pointers(arena->end, arena->start.ptr);
+    }
+    block.segoff.offset = MEM_SIZE_PARAGRAPH;   // usable space follows the header
+    arena->start = block;
+    arena->free = block.ptr;
+    block.segoff.offset = paragraphs * MEM_SIZE_PARAGRAPH;
+    arena->end = block.ptr;
+    return 1;
+}
+
+/**
+ * @brief Frees the current chained block and makes the previous one current
+ * @note The previous block is left full - its free pointer is at its end
+ */
+static void private_mem_arena_chain_unlink(mem_arena_t* arena) {
+    mem_arena_chain_header_t* header = private_mem_arena_chain_header(arena);
+    uint16_t prev_segment = header->prev_segment;
+    dos_free_allocated_memory_blocks(arena->start.segoff.segment);
+    arena->start.segoff.segment = prev_segment;
+    arena->start.segoff.offset = MEM_SIZE_PARAGRAPH;
+    arena->free = arena->end = arena->start.ptr;
+    if (prev_segment) {
+        mem_address_t end = arena->start;
+        end.segoff.offset = private_mem_arena_chain_header(arena)->paragraphs * MEM_SIZE_PARAGRAPH;
+        arena->free = arena->end = end.ptr;
+        arena->retired -= mem_diff_pointers(arena->end, arena->start.ptr);
+    }
+}
+
+/**
+ * @brief Links a block big enough for byte_request, growing geometrically
+ * @param arena Chained arena whose current block is exhausted
+ * @param byte_request Size of the allocation that did not fit
+ * @return 1 on success, 0 if the request is too big or DOS is out of memory
+ */
+static int private_mem_arena_chain_grow(mem_arena_t* arena, mem_size_t byte_request) {
+    mem_size_t needed = (byte_request / MEM_SIZE_PARAGRAPH) + ((byte_request % MEM_SIZE_PARAGRAPH) ? 1 : 0) + 1;
+    mem_size_t paragraphs = (arena->start.segoff.segment) ? (mem_size_t)private_mem_arena_chain_header(arena)->paragraphs * 2 : 0;
+    mem_size_t available = mem_max_paragraphs();
+    if (paragraphs > MEM_ARENA_CHAIN_MAX_PARAGRAPHS) {
+        paragraphs = MEM_ARENA_CHAIN_MAX_PARAGRAPHS;
+    }
+    if (paragraphs > available) {
+        paragraphs = available;
+    }
+    if (paragraphs < needed) {
+        paragraphs = needed;
+    }
+    if (paragraphs > MEM_ARENA_CHAIN_MAX_PARAGRAPHS || paragraphs > available) {
+        return 0;
+    }
+    return private_mem_arena_chain_link(arena, (uint16_t)paragraphs);
+}
+
+/**
+ * @brief Creates a chained DOS memory arena
+ * @param byte_count Size of the first block in bytes
+ * @return Initialized arena or NULL on failure
+ */
+mem_arena_t* private_mem_arena_chained_new(mem_size_t byte_count) {
+    assert(byte_count);
+    if (!byte_count) {
+        return NULL;
+    }
+    mem_arena_t* arena = (mem_arena_t*)malloc(sizeof(mem_arena_t));
+    assert(arena != NULL);
+    *arena = default_dos_mem_arena_t;
+    arena->policy = MEM_ARENA_POLICY_CHAINED;
+    mem_size_t paragraphs = (byte_count / MEM_SIZE_PARAGRAPH) + ((byte_count % MEM_SIZE_PARAGRAPH) ? 1 : 0) + 1;
+    if (paragraphs > MEM_ARENA_CHAIN_MAX_PARAGRAPHS) {
+        paragraphs = MEM_ARENA_CHAIN_MAX_PARAGRAPHS;
+    }
+    if (!private_mem_arena_chain_link(arena, (uint16_t)paragraphs)) {
+#ifndef NDEBUG
+        fprintf(stderr, "DOS allocation failed: Requested %lu bytes (%lu paragraphs)\n", byte_count, paragraphs);
+#endif
+    }
+    return arena;
+}
+
+/**
+ * @brief Releases every block of a chained arena
+ * @param arena Valid chained arena
+ * @return Bytes freed
+ */
+mem_size_t private_mem_arena_chained_delete(mem_arena_t* arena) {
+    assert(arena && arena->policy == MEM_ARENA_POLICY_CHAINED);
+    mem_size_t freed = mem_arena_capacity(arena);
+    while (arena->start.segoff.segment) {
+        private_mem_arena_chain_unlink(arena);
+    }
+    free(arena);
+    return freed;
+}
+
+/* ----------------- EMS-Specific Implementation ----------------- */
+
+/**
+ * @brief Creates an expanded memory arena via INT 67h
+ * @param byte_count Requested size in bytes (rounded up to 16KB pages)
+ * @return Initialized arena or NULL if there is no EMS or not enough of it
+ *
+ * @details start, free and end hold logical offsets within the handle's
+ *          pages in their 32-bit memloc view rather than addresses. Logical space
+ *          starts one page in (MEM_EMS_LOGICAL_BASE) so no allocation is ever the
+ *          far NULL 0000:0000; mem_arena_ems_map() takes the base off again.
+ */
+mem_arena_t* private_mem_arena_ems_new(mem_size_t byte_count) {
+    assert(byte_count);
+    if (!byte_count || !mem_ems_present()) {
+        return NULL;
+    }
+    uint16_t pages = (uint16_t)((byte_count / MEM_EMS_PAGE_SIZE) + ((byte_count % MEM_EMS_PAGE_SIZE) ? 1 : 0));
+    uint16_t handle;
+    if (mem_ems_allocate_pages(pages, &handle)) {
+        return NULL;
+    }
+    mem_arena_t* arena = (mem_arena_t*)malloc(sizeof(mem_arena_t));
+    assert(arena != NULL);
+    *arena = default_dos_mem_arena_t;
+    arena->policy = MEM_ARENA_POLICY_EMS;
+    arena->ems_handle = handle;
+    arena->start.memloc = MEM_EMS_LOGICAL_BASE;
+    arena->free = arena->start.ptr;
+    mem_address_t end;
+    end.memloc = MEM_EMS_LOGICAL_BASE + (uint32_t)pages * MEM_EMS_PAGE_SIZE;
+    arena->end = end.ptr;
+    return arena;
+}
+
+/**
+ * @brief Releases an expanded memory arena
+ * @param arena Valid EMS arena
+ * @return Bytes freed
+ */
+mem_size_t private_mem_arena_ems_delete(mem_arena_t* arena) {
+    assert(arena && arena->policy == MEM_ARENA_POLICY_EMS);
+    mem_size_t freed = mem_arena_capacity(arena);
+    mem_ems_release_pages(arena->ems_handle);
+    free(arena);
+    return freed;
+}
+
+/**
+ * @brief Skips to the next EMS page if byte_request would straddle the current one
+ * @return false if the request is larger than a page, or would straddle and the
+ *         arena has no room for it after the padding
+ */
+static bool private_mem_arena_ems_pad(mem_arena_t* arena, mem_size_t byte_request) {
+    if (byte_request > MEM_EMS_PAGE_SIZE) {
+        return false;
+    }
+    mem_address_t logical;
+    logical.ptr = arena->free;
+    mem_size_t in_page = logical.memloc % MEM_EMS_PAGE_SIZE;
+    if (in_page + byte_request > MEM_EMS_PAGE_SIZE) {
+        if (MEM_EMS_PAGE_SIZE - in_page + byte_request > mem_arena_size(arena)) {
+            return false;   // unpadded it would run past the mapped page
+        }
+        private_mem_arena_bump(arena, MEM_EMS_PAGE_SIZE - in_page);
+    }
+    return true;
+}
+
+/* ----------------- Logical Differences ----------------- */
+
+/**
+ * @brief Byte difference of two positions in an arena (p1 - p2)
+ * @details Physical for memory arenas, logical for EMS arenas
+ */
+static mem_diff_t private_mem_arena_diff(mem_arena_t* arena, const char* p1, const char* p2) {
+    if (arena->policy == MEM_ARENA_POLICY_EMS) {
+        mem_address_t a, b;
+        a.ptr = (char*)p1;
+        b.ptr = (char*)p2;
+        return (mem_diff_t)(a.memloc - b.memloc);
+    }
+    return mem_diff_linear(p1, p2);
+}
+
 /* ----------------- C99-Specific Implementation ----------------- */
 
 /**
@@ -132,6 +436,7 @@ mem_arena_t* private_mem_arena_c_new(mem_size_t byte_count) {
 
     arena->free = arena->start.ptr;
     arena->end = arena->start.ptr + byte_count;
+    arena->retired = 0;
 
     return arena;
 }
@@ -150,19 +455,51 @@ mem_size_t private_mem_arena_c_delete(mem_arena_t* arena) {
 }
 
 
+/* ----------------- Sub-Arena Implementation ----------------- */
+
+/**
+ * @brief Releases a sub-arena handle
+ * @param arena Valid sub-arena
+ * @return Bytes handed back (still owned by the parent)
+ */
+mem_size_t private_mem_arena_sub_delete(mem_arena_t* arena) {
+    assert(arena && arena->policy == MEM_ARENA_POLICY_SUB);
+    mem_size_t freed = mem_arena_capacity(arena);
+    free(arena);
+    return freed;
+}
+
 /* ----------------- Public Interface ----------------- */
 
 mem_arena_t* mem_arena_create(mem_arena_policy_t policy, mem_size_t byte_request) {
 	assert(byte_request);
+    mem_arena_t* arena = NULL;
     switch(policy) {
         case MEM_ARENA_POLICY_DOS:
-            return private_mem_arena_dos_new(byte_request);
+            arena = private_mem_arena_dos_new(byte_request);
+            break;
         case MEM_ARENA_POLICY_C:
-            return private_mem_arena_c_new(byte_request);
+            arena = private_mem_arena_c_new(byte_request);
+            break;
+        case MEM_ARENA_POLICY_HUGE:
+            arena = private_mem_arena_huge_new(byte_request);
+            break;
+        case MEM_ARENA_POLICY_CHAINED:
+            arena = private_mem_arena_chained_new(byte_request);
+            break;
+        case MEM_ARENA_POLICY_EMS:
+            arena = private_mem_arena_ems_new(byte_request);
+            break;
         default:
             fprintf(stderr, "Unimplemented policy: %d\n", policy);
             return NULL;
     }
+#ifdef MEM_ARENA_STATS
+    if (arena) {
+        memset(&arena->stats, 0, sizeof(mem_arena_stats_t));
+    }
+#endif
+    return arena;
 }
 
 mem_size_t mem_arena_delete(mem_arena_t* arena) {
@@ -172,20 +509,58 @@ mem_size_t mem_arena_delete(mem_arena_t* arena) {
     }
     switch(arena->policy) {
         case MEM_ARENA_POLICY_DOS:
+        case MEM_ARENA_POLICY_HUGE:
             return private_mem_arena_dos_delete(arena);
         case MEM_ARENA_POLICY_C:
             return private_mem_arena_c_delete(arena);
+        case MEM_ARENA_POLICY_SUB:
+            return private_mem_arena_sub_delete(arena);
+        case MEM_ARENA_POLICY_CHAINED:
+            return private_mem_arena_chained_delete(arena);
+        case MEM_ARENA_POLICY_EMS:
+            return private_mem_arena_ems_delete(arena);
         default:
             fprintf(stderr, "Unimplemented policy: %d\n", arena->policy);
             return 0;
     }
 }
 
+mem_arena_t* mem_arena_create_sub(mem_arena_t* parent, mem_size_t byte_request) {
+    assert(parent && parent->policy != MEM_ARENA_POLICY_EMS && "EMS memory has no real-mode address!");
+    assert(byte_request && byte_request <= 0xFFF0UL && "A slice must fit one segment from offset 0!");
+    if (!parent || parent->policy == MEM_ARENA_POLICY_EMS || !byte_request || byte_request > 0xFFF0UL) {
+        return NULL;
+    }
+    mem_size_t paragraphs = (byte_request / MEM_SIZE_PARAGRAPH) + ((byte_request % MEM_SIZE_PARAGRAPH) ? 1 : 0);
+    mem_arena_mark_t mark = mem_arena_mark(parent);
+    mem_address_t slice;
+    slice.ptr = (char*)mem_arena_alloc_aligned(parent, paragraphs * MEM_SIZE_PARAGRAPH, MEM_SIZE_PARAGRAPH);
+    if (!slice.ptr) {
+        return NULL;
+    }
+    mem_arena_t* arena = (mem_arena_t*)malloc(sizeof(mem_arena_t));
+    if (!arena) {
+        mem_arena_rewind(parent, mark);     // the alignment padding too
+        return NULL;
+    }
+    slice.segoff.segment += slice.segoff.offset / MEM_SIZE_PARAGRAPH;   // normalize to seg:0000
+    slice.segoff.offset = 0;
+    arena->policy = MEM_ARENA_POLICY_SUB;
+    arena->retired = 0;
+#ifdef MEM_ARENA_STATS
+    memset(&arena->stats, 0, sizeof(mem_arena_stats_t));
+#endif
+    arena->start = slice;
+    arena->free = arena->start.ptr;
+    arena->end = arena->start.ptr + (paragraphs * MEM_SIZE_PARAGRAPH);
+    return arena;
+}
+
 /* ----------------- Accessors ----------------- */
 
 char* mem_arena_dos_mcb(mem_arena_t* arena) {
-	assert(arena && arena->policy == MEM_ARENA_POLICY_DOS);
-	if(!arena || arena->policy != MEM_ARENA_POLICY_DOS) {
+	assert(arena && (arena->policy == MEM_ARENA_POLICY_DOS || arena->policy == MEM_ARENA_POLICY_HUGE));
+	if(!arena || (arena->policy != MEM_ARENA_POLICY_DOS && arena->policy != MEM_ARENA_POLICY_HUGE)) {
 	    return NULL;
 	}
 	mem_address_t m = arena->start;
@@ -194,11 +569,11 @@ char* mem_arena_dos_mcb(mem_arena_t* arena) {
 }
 
 mem_size_t mem_arena_size(mem_arena_t* arena) {
-	return mem_diff_pointers(arena->end, arena->free);
+	return private_mem_arena_diff(arena, arena->end, arena->free);
 }
 
 mem_size_t mem_arena_capacity(mem_arena_t* arena) {
-	return mem_diff_pointers(arena->end, arena->start.ptr);
+	return arena->retired + private_mem_arena_diff(arena, arena->end, arena->start.ptr);
 }
 
 mem_size_t mem_arena_used(mem_arena_t* arena) {
@@ -220,11 +595,30 @@ void* mem_arena_free_address(mem_arena_t* arena) {
 /* ----------------- Allocation ----------------- */
 
 void* mem_arena_alloc(mem_arena_t* arena, mem_size_t byte_request) {
-	if (arena && byte_request && byte_request <= mem_arena_size(arena)) {
+    if (arena && arena->policy == MEM_ARENA_POLICY_EMS && !private_mem_arena_ems_pad(arena, byte_request)) {
+        byte_request = 0;   // larger than an EMS page or cannot be kept within one
+    }
+	if (arena && byte_request && byte_request <= mem_arena_size(arena)
+        && (arena->policy != MEM_ARENA_POLICY_HUGE || byte_request <= MEM_HUGE_MAX_ALLOCATE)) {
         void* ptr = arena->free;
-        arena->free += byte_request;
+        private_mem_arena_bump(arena, byte_request);
+#ifdef MEM_ARENA_STATS
+        ++arena->stats.allocations;
+        if (mem_arena_used(arena) > arena->stats.peak) {
+            arena->stats.peak = mem_arena_used(arena);
+        }
+#endif
         return ptr;
     }
+    if (arena && arena->policy == MEM_ARENA_POLICY_CHAINED && byte_request
+        && private_mem_arena_chain_grow(arena, byte_request)) {
+        return mem_arena_alloc(arena, byte_request);     // the fresh block always fits
+    }
+#ifdef MEM_ARENA_STATS
+    if (arena) {
+        ++arena->stats.failures;
+    }
+#endif
 #ifndef NDEBUG
     fprintf(stderr, "Allocation failed: Requested %lu, Available %lu\n",
            byte_request, mem_arena_size(arena));
@@ -232,9 +626,46 @@ void* mem_arena_alloc(mem_arena_t* arena, mem_size_t byte_request) {
     return NULL;
 }
 
-void* mem_arena_calloc(mem_arena_t* arena, mem_size_t byte_request) {
+void* mem_arena_alloc_tagged(mem_arena_t* arena, mem_size_t byte_request, const char* tag) {
+    assert(tag);
     void* ptr = mem_arena_alloc(arena, byte_request);
+#ifdef MEM_ARENA_STATS
     if (ptr) {
+        private_mem_arena_stats_tag(arena, tag, byte_request);
+    }
+#endif
+    return ptr;
+}
+
+void* mem_arena_alloc_aligned(mem_arena_t* arena, mem_size_t byte_request, uint8_t align) {
+    assert(align && align <= MEM_SIZE_PARAGRAPH && !(align & (align - 1)) && "ALIGN must be a power of two <= 16!");
+    if (!arena) {
+        return NULL;
+    }
+    mem_address_t free_address;
+    free_address.ptr = arena->free;
+    mem_size_t padding = (uint16_t)(-free_address.segoff.offset) & (align - 1);
+    if (byte_request && padding + byte_request > mem_arena_size(arena)
+        && arena->policy == MEM_ARENA_POLICY_CHAINED && private_mem_arena_chain_grow(arena, byte_request)) {
+        free_address.ptr = arena->free;     // fresh blocks start paragraph aligned
+        padding = (uint16_t)(-free_address.segoff.offset) & (align - 1);
+    }
+    if (!byte_request || padding + byte_request > mem_arena_size(arena)) {
+#ifdef MEM_ARENA_STATS
+        ++arena->stats.failures;
+#endif
+        return NULL;    // never hand out misaligned memory
+    }
+    private_mem_arena_bump(arena, padding);
+    return mem_arena_alloc(arena, byte_request);
+}
+
+void* mem_arena_calloc(mem_arena_t* arena, mem_size_t byte_request) {
+    void* ptr = mem_arena_alloc(arena, byte_request);
+    if (ptr && arena->policy == MEM_ARENA_POLICY_EMS) {
+        memset(mem_arena_ems_map(arena, ptr), 0, byte_request);
+    }
+    else if (ptr) {
         #if defined(__WATCOMC__) && defined(__386__) // Use optimized platform-specific zeroing
         _fmemset(ptr, 0, byte_request);  // Watcom fast memset
         #else
@@ -245,8 +676,8 @@ void* mem_arena_calloc(mem_arena_t* arena, mem_size_t byte_request) {
 }
 
 void* mem_arena_dealloc(mem_arena_t* arena, mem_size_t byte_request) {
-	if (arena && byte_request && byte_request <= mem_arena_used(arena)) {
-        arena->free -= byte_request;
+	if (arena && byte_request && byte_request <= (mem_size_t)private_mem_arena_diff(arena, arena->free, arena->start.ptr)) {
+        private_mem_arena_bump(arena, -(mem_diff_t)byte_request);
         return arena->free;
     }
 #ifndef NDEBUG
@@ -255,8 +686,52 @@ void* mem_arena_dealloc(mem_arena_t* arena, mem_size_t byte_request) {
     return NULL;
 }
 
+void* mem_arena_ems_map(mem_arena_t* arena, const void* logical) {
+    assert(arena && arena->policy == MEM_ARENA_POLICY_EMS);
+    mem_address_t offset;
+    offset.ptr = (char*)logical;
+    assert(offset.memloc >= MEM_EMS_LOGICAL_BASE && "NOT an EMS arena allocation!");
+    offset.memloc -= MEM_EMS_LOGICAL_BASE;
+    char* page = (char*)mem_ems_map(arena->ems_handle, (uint16_t)(offset.memloc / MEM_EMS_PAGE_SIZE));
+    return (page) ? page + (uint16_t)(offset.memloc % MEM_EMS_PAGE_SIZE) : NULL;
+}
+
+/* ----------------- Save Points ----------------- */
+
+mem_arena_mark_t mem_arena_mark(mem_arena_t* arena) {
+    assert(arena);
+    mem_arena_mark_t mark = { arena->free };
+    return mark;
+}
+
+mem_size_t mem_arena_rewind(mem_arena_t* arena, mem_arena_mark_t mark) {
+    assert(arena);
+    mem_size_t used = mem_arena_used(arena);
+    if (arena->policy == MEM_ARENA_POLICY_CHAINED) {
+        mem_address_t block;
+        block.ptr = mark.free;
+        while (arena->start.segoff.segment && arena->start.segoff.segment != block.segoff.segment) {
+            private_mem_arena_chain_unlink(arena);  // blocks linked after the mark
+        }
+        assert(arena->start.segoff.segment && "MARK is not from this arena!");
+    }
+    assert(private_mem_arena_diff(arena, mark.free, arena->start.ptr) >= 0 && "MARK is not from this arena!");
+    assert(private_mem_arena_diff(arena, arena->free, mark.free) >= 0 && "MARK is already released!");
+    arena->free = mark.free;
+    return used - mem_arena_used(arena);
+}
+
 /* ----------------- Debugging ----------------- */
 
+const mem_arena_stats_t* mem_arena_stats(mem_arena_t* arena) {
+    assert(arena);
+#ifdef MEM_ARENA_STATS
+    return &arena->stats;
+#else
+    return NULL;
+#endif
+}
+
 void mem_arena_dump(FILE* output_stream, mem_arena_t* arena) {
     if (!output_stream || !arena) return;
 
@@ -275,9 +750,28 @@ void mem_arena_dump(FILE* output_stream, mem_arena_t* arena) {
            mem_arena_used(arena),
            mem_arena_size(arena));
 
-    if (arena->policy == MEM_ARENA_POLICY_DOS) {
+    if (arena->policy == MEM_ARENA_POLICY_DOS || arena->policy == MEM_ARENA_POLICY_HUGE) {
         fprintf(output_stream, "MCB: %p\n", mem_arena_dos_mcb(arena));
     }
+    else if (arena->policy == MEM_ARENA_POLICY_EMS) {
+        fprintf(output_stream, "EMS handle: %u\n", arena->ems_handle);
+    }
+
+#ifdef MEM_ARENA_STATS
+    fprintf(output_stream,
+           "Peak: %lu bytes\n"
+           "Allocations: %lu\n"
+           "Failures: %lu\n",
+           arena->stats.peak,
+           arena->stats.allocations,
+           arena->stats.failures);
+    for (uint8_t i = 0; i < arena->stats.tag_count; ++i) {
+        fprintf(output_stream, "Tag %-12s %lu bytes in %lu\n",
+               arena->stats.tags[i].tag,
+               arena->stats.tags[i].bytes,
+               arena->stats.tags[i].count);
+    }
+#endif
 
     fflush(output_stream);
 }
@@ -21,18 +21,30 @@
  *     node [shape=box, fontname="Courier New"];
  *     DOS [label="DOS Policy\n(INT 21h allocations)"];
  *     C [label="C Policy\n(malloc/free backend)"];
+ *     SUB [label="Sub Policy\n(paragraph-aligned slice of a parent)"];
+ *     HUGE [label="Huge Policy\n(INT 21h, > 64KB, normalized pointers)"];
+ *     CHAINED [label="Chained Policy\n(INT 21h blocks linked on demand)"];
+ *     EMS [label="EMS Policy\n(INT 67h pages, logical offsets)"];
  * }
  * @enddot
  */
 typedef enum {
   MEM_ARENA_POLICY_DOS,
-  MEM_ARENA_POLICY_C
+  MEM_ARENA_POLICY_C,
+  MEM_ARENA_POLICY_SUB,
+  MEM_ARENA_POLICY_HUGE,
+  MEM_ARENA_POLICY_CHAINED,
+  MEM_ARENA_POLICY_EMS
 } mem_arena_policy_t;
 
 /// Human-readable policy names
-static const char mem_policy_info[2][31] = {
+static const char mem_policy_info[6][31] = {
 	 "MEM_POLICY_DOS",
-	 "MEM_POLICY_C"
+	 "MEM_POLICY_C",
+	 "MEM_POLICY_SUB",
+	 "MEM_POLICY_HUGE",
+	 "MEM_POLICY_CHAINED",
+	 "MEM_POLICY_EMS"
 };
 
 /* ----------------- Arena Structure ----------------- */
@@ -50,6 +62,37 @@ static const char mem_policy_info[2][31] = {
  */
 typedef struct private_mem_arena_t mem_arena_t;
 
+/**
+ * @brief Arena checkpoint returned by mem_arena_mark()
+ *
+ * @warning Contents are private - only pass it back to mem_arena_rewind()
+ */
+typedef struct {
+    char* free;             ///< Allocation pointer at the time of the mark
+} mem_arena_mark_t;
+
+/**
+ * @brief Allocation totals for one call-site tag
+ */
+typedef struct {
+    const char* tag;        ///< Tag passed to mem_arena_alloc_tagged()
+    mem_size_t bytes;       ///< Bytes allocated under the tag
+    mem_size_t count;       ///< Allocations made under the tag
+} mem_arena_tag_stats_t;
+
+/**
+ * @brief Arena instrumentation (compiled in with MEM_ARENA_STATS)
+ *
+ * @note Peak usage is what sizes an arena for a 256KB vs 640KB machine
+ */
+typedef struct {
+    mem_size_t peak;                                ///< High-water mark of used bytes
+    mem_size_t allocations;                         ///< Successful allocations
+    mem_size_t failures;                            ///< Requests that returned NULL
+    uint8_t tag_count;                              ///< Entries used in tags[]
+    mem_arena_tag_stats_t tags[MEM_ARENA_MAX_TAGS]; ///< Per call-site totals
+} mem_arena_stats_t;
+
 /* ----------------- Core Operations ----------------- */
 
 /**
@@ -68,10 +111,36 @@ typedef struct private_mem_arena_t mem_arena_t;
  * @endcode
  *
  * @note For DOS policy, maximum initial size is 65535 paragraphs (≈1MB)
+ *       but pointer arithmetic wraps at 64KB - use MEM_ARENA_POLICY_HUGE beyond that.
+ *       A huge arena re-normalizes its free pointer after every bump, so each
+ *       allocation (≤ MEM_HUGE_MAX_ALLOCATE bytes) lies within a single segment.
+ * @note A chained arena starts with one DOS block of byte_request and, when it is
+ *       exhausted, links another twice the size of the last (capped by
+ *       MEM_ARENA_CHAIN_MAX_PARAGRAPHS and mem_max_paragraphs()). Size and base
+ *       address refer to the current block, capacity and used to the whole chain.
+ * @note An EMS arena allocates byte_request rounded up to 16KB pages of expanded
+ *       memory. Its allocations are logical offsets, not addresses - pass them to
+ *       mem_arena_ems_map() before use. No allocation straddles a page. Pools,
+ *       sub-arenas, widgets, transposition tables and the profiler refuse EMS arenas.
  * @see mem_arena_delete()
  */
 mem_arena_t* mem_arena_create(mem_arena_policy_t policy, mem_size_t byte_request);
 
+/**
+ * @brief Creates a child arena that starts at offset 0 of its own segment
+ * @param parent Valid non-EMS arena handle the memory is taken from
+ * @param byte_request Size in bytes (<= 0xFFF0, rounded up to whole paragraphs)
+ * @return Arena handle or NULL if the parent is full
+ *
+ * @details The slice is paragraph aligned in the parent and its address normalized,
+ *          i.e. segment += offset / 16, offset = 0. Tables placed in it can be reached
+ *          with a single segment register and near offsets.
+ *
+ * @note Deleting the child only frees its handle - the memory belongs to the parent
+ *       and is released by deleting (or rewinding) the parent
+ */
+mem_arena_t* mem_arena_create_sub(mem_arena_t* parent, mem_size_t byte_request);
+
 /**
  * @brief Destroys an arena and all its allocations
  * @param arena Valid arena handle
@@ -146,12 +215,40 @@ void* mem_arena_free_address(mem_arena_t* arena);
  * @details Allocation Characteristics:
  *          - O(1) time complexity
  *          - No per-allocation overhead
- *          - Naturally aligned (8/16/32-bit)
+ *          - Alignment follows earlier requests - use mem_arena_alloc_aligned()
+ *            when it matters
  *
  * @warning Lifetime matches arena - no individual freeing
  */
 void* mem_arena_alloc(mem_arena_t* arena, mem_size_t byte_request);
 
+/**
+ * @brief Allocates memory from arena and accounts it to a call-site tag
+ * @param arena Valid arena handle
+ * @param byte_request Size needed
+ * @param tag Static string naming the call site (e.g. "tt", "widgets")
+ * @return Pointer to memory or NULL if full
+ *
+ * @note Same as mem_arena_alloc() unless compiled with MEM_ARENA_STATS
+ */
+void* mem_arena_alloc_tagged(mem_arena_t* arena, mem_size_t byte_request, const char* tag);
+
+/**
+ * @brief Allocates memory from arena at an aligned address
+ * @param arena Valid arena handle
+ * @param byte_request Size needed
+ * @param align Power of two from 1 to 16 (paragraph)
+ * @return Pointer to memory or NULL if the request plus its padding does not fit
+ *
+ * @details The free pointer is padded until its offset is a multiple of align.
+ *          Chained arenas link a new block first when the padding would not fit.
+ *          With segment * 16 always paragraph aligned, the offset alone
+ *          decides the alignment of the physical address.
+ *
+ * @note Word alignment (2) halves the fetch cost of 16-bit data on 16-bit buses
+ */
+void* mem_arena_alloc_aligned(mem_arena_t* arena, mem_size_t byte_request, uint8_t align);
+
 /**
  * @brief Allocates and zero-initializes memory from arena
  * @param arena Valid arena handle
@@ -173,8 +270,67 @@ void* mem_arena_calloc(mem_arena_t* arena, mem_size_t byte_request);
  */
 void* mem_arena_dealloc(mem_arena_t* arena, mem_size_t byte_request);
 
+/**
+ * @brief Maps an allocation of an EMS arena into the page frame
+ * @param arena Arena created with EMS policy
+ * @param logical Value returned by an allocation from that arena
+ * @return Far pointer usable until four other EMS pages are mapped, NULL on error
+ *
+ * @note Repeated probes to the same 16KB page hit the mapping cache
+ * @see mem_ems_map()
+ */
+void* mem_arena_ems_map(mem_arena_t* arena, const void* logical);
+
+/* ----------------- Save Points ----------------- */
+
+/**
+ * @brief Records the current allocation position
+ * @param arena Valid arena handle
+ * @return Checkpoint for mem_arena_rewind()
+ *
+ * @note O(1) and allocation free - marks may be nested like a stack
+ */
+mem_arena_mark_t mem_arena_mark(mem_arena_t* arena);
+
+/**
+ * @brief Releases everything allocated since mark was taken
+ * @param arena Arena the mark was taken from
+ * @param mark Checkpoint from mem_arena_mark()
+ * @return Bytes released
+ *
+ * @warning Pointers allocated after the mark become invalid,
+ *          as do any marks taken after it
+ * @note Chained arenas free any blocks linked after the mark was taken
+ */
+mem_size_t mem_arena_rewind(mem_arena_t* arena, mem_arena_mark_t mark);
+
+/**
+ * @brief Runs the following statement/block with a scratch lifetime
+ * @param arena Valid arena handle
+ *
+ * @code
+ * MEM_ARENA_SCOPE(arena) {
+ *     char* fen = mem_arena_alloc(arena, 90);
+ *     ...
+ * }   // everything allocated in the block is released here
+ * @endcode
+ *
+ * @warning Leaving the block with break, goto or return skips the rewind
+ */
+#define MEM_ARENA_SCOPE(arena) \
+    for(mem_arena_mark_t mem_arena_scope_mark = mem_arena_mark(arena), *mem_arena_scope_once = &mem_arena_scope_mark; \
+        mem_arena_scope_once; \
+        mem_arena_rewind((arena), mem_arena_scope_mark), mem_arena_scope_once = NULL)
+
 /* ----------------- Debugging ----------------- */
 
+/**
+ * @brief Gets arena instrumentation
+ * @param arena Valid arena handle
+ * @return Statistics or NULL if not compiled with MEM_ARENA_STATS
+ */
+const mem_arena_stats_t* mem_arena_stats(mem_arena_t* arena);
+
 /**
  * @brief Dumps arena metadata to stream
  * @param output_stream File/console output
@@ -188,6 +344,8 @@ void* mem_arena_dealloc(mem_arena_t* arena, mem_size_t byte_request);
  * Used: 12.3 KB (19%)
  * MCB: 0x5678 (Owner: 0x0008)
  * @endcode
+ *
+ * @note With MEM_ARENA_STATS also prints peak, counts and per-tag totals
  */
 void mem_arena_dump(FILE* output_stream, mem_arena_t* arena);
 
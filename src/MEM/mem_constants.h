@@ -28,6 +28,47 @@
 */
 #define MEM_MAX_DOS_ALLOCATE 1048560
 
+/**
+* Bytes per dos_read_file/dos_write_file call when loading or saving more than 64KB.
+* 32KB keeps every chunk inside one segment of a normalized far pointer.
+*/
+#define MEM_FILE_CHUNK_SIZE 0x8000U
+
+/**
+* Largest single allocation from a huge arena. Its free pointer is kept normalized (offset 0 - 0Fh)
+* so a block of up to 65536 - 16 bytes always fits in one segment without the offset wrapping.
+*/
+#define MEM_HUGE_MAX_ALLOCATE 0xFFF0
+
+/**
+* Largest block a chained arena links in, header paragraph included. Keeping each block below 64KB
+* lets the bump pointer stay a plain far pointer within the block's own segment (end offset FFF0h).
+*/
+#define MEM_ARENA_CHAIN_MAX_PARAGRAPHS 0x0FFF
+
+/**
+* Distinct call-site tags an instrumented arena (compiled with MEM_ARENA_STATS) keeps totals for.
+* Allocations under further tags are still counted in the arena totals.
+*/
+#define MEM_ARENA_MAX_TAGS 8
+
+/**
+* LIM EMS 4.0 - Expanded Memory Specification, INT 67h services (AH)
+* The page frame is a 64KB window in upper memory holding four 16KB physical pages,
+* logical pages of an EMS handle are mapped into it on demand.
+*/
+#define MEM_EMS_SERVICE             67h
+#define MEM_EMS_GET_STATUS          40h
+#define MEM_EMS_GET_PAGE_FRAME      41h
+#define MEM_EMS_GET_PAGE_COUNTS     42h
+#define MEM_EMS_ALLOCATE_PAGES      43h
+#define MEM_EMS_MAP_PAGE            44h
+#define MEM_EMS_RELEASE_PAGES       45h
+#define MEM_EMS_INTERRUPT           0x67
+#define MEM_EMS_PAGE_SIZE           16384U
+#define MEM_EMS_PHYSICAL_PAGES      4
+#define MEM_EMS_LOGICAL_BASE        ((uint32_t)MEM_EMS_PAGE_SIZE)   // first logical offset of an EMS arena, never NULL
+
 /**
 * MCB - DOS Memory Control Block size 16 bytes ie a paragraph
 */
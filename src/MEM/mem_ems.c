@@ -0,0 +1,211 @@
+/**
+ * @file mem_ems.c
+ * @brief LIM EMS 4.0 services and page-mapping cache implementation
+ * @defgroup memory_ems_impl Expanded Memory Internals
+ * @{
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mem_ems.h"
+#include "mem_types.h"
+
+#include "../DOS/dos_services.h"
+
+/// Device name an EMM driver places at offset 0Ah of its INT 67h segment
+static const char mem_ems_device_name[] = "EMMXXXX0";
+
+/* ----------------- Mapping Cache ----------------- */
+
+/**
+ * @brief One physical page of the frame and what is mapped in it
+ */
+typedef struct {
+    uint16_t handle;        ///< Owner of the mapped page
+    uint16_t logical_page;  ///< Mapped logical page
+    bool valid;             ///< Slot holds a mapping
+} mem_ems_slot_t;
+
+static mem_ems_slot_t mem_ems_cache[MEM_EMS_PHYSICAL_PAGES];
+static uint8_t mem_ems_victim = 0;
+static uint32_t mem_ems_misses = 0;
+static uint16_t mem_ems_frame = 0;
+
+/* ----------------- Driver ----------------- */
+
+bool mem_ems_present() {
+    mem_address_t vector;
+    vector.ptr = (char*)dos_get_interrupt_vector(MEM_EMS_INTERRUPT);
+    if (!vector.segoff.segment) {
+        return false;
+    }
+    vector.segoff.offset = 0x0A;
+    return memcmp(vector.ptr, mem_ems_device_name, sizeof(mem_ems_device_name) - 1) == 0;
+}
+
+uint8_t mem_ems_status() {
+    uint8_t status = 0;
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        mov     ah, MEM_EMS_GET_STATUS      ; 40h get status
+        int     MEM_EMS_SERVICE
+        mov     status, ah
+
+        pop     ds
+        popf
+    }
+    return status;
+}
+
+uint16_t mem_ems_page_frame() {
+    uint16_t frame = 0;
+    uint8_t status = 0;
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        mov     ah, MEM_EMS_GET_PAGE_FRAME  ; 41h get page frame address
+        int     MEM_EMS_SERVICE
+        mov     status, ah
+        mov     frame, bx                   ; segment of the 64KB window
+
+        pop     ds
+        popf
+    }
+    return (status) ? 0 : frame;
+}
+
+uint16_t mem_ems_free_pages() {
+    uint16_t pages = 0;
+    uint8_t status = 0;
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        mov     ah, MEM_EMS_GET_PAGE_COUNTS ; 42h get unallocated page count
+        int     MEM_EMS_SERVICE
+        mov     status, ah
+        mov     pages, bx                   ; unallocated, DX = total
+
+        pop     ds
+        popf
+    }
+    return (status) ? 0 : pages;
+}
+
+/* ----------------- Handles ----------------- */
+
+uint8_t mem_ems_allocate_pages(uint16_t pages, uint16_t* handle) {
+    assert(handle);
+    uint16_t allocated = 0;
+    uint8_t status = 0;
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        mov     bx, pages                   ; logical pages requested
+        mov     ah, MEM_EMS_ALLOCATE_PAGES  ; 43h allocate pages
+        int     MEM_EMS_SERVICE
+        mov     status, ah
+        mov     allocated, dx               ; handle
+
+        pop     ds
+        popf
+    }
+    if (!status) {
+        *handle = allocated;
+    }
+#ifndef NDEBUG
+    else {
+        fprintf(stderr, "EMS allocation failed: Requested %u pages, status %02Xh\n", pages, status);
+    }
+#endif
+    return status;
+}
+
+uint8_t mem_ems_map_page(uint16_t handle, uint8_t physical_page, uint16_t logical_page) {
+    uint8_t status = 0;
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        mov     al, physical_page           ; 0 - 3 within the page frame
+        mov     bx, logical_page
+        mov     dx, handle
+        mov     ah, MEM_EMS_MAP_PAGE        ; 44h map logical page
+        int     MEM_EMS_SERVICE
+        mov     status, ah
+
+        pop     ds
+        popf
+    }
+    return status;
+}
+
+uint8_t mem_ems_release_pages(uint16_t handle) {
+    uint8_t status = 0;
+    for (uint8_t i = 0; i < MEM_EMS_PHYSICAL_PAGES; ++i) {
+        if (mem_ems_cache[i].valid && mem_ems_cache[i].handle == handle) {
+            mem_ems_cache[i].valid = false;
+        }
+    }
+    __asm {
+        .8086
+        pushf
+        push    ds
+
+        mov     dx, handle
+        mov     ah, MEM_EMS_RELEASE_PAGES   ; 45h release handle and memory
+        int     MEM_EMS_SERVICE
+        mov     status, ah
+
+        pop     ds
+        popf
+    }
+    return status;
+}
+
+/* ----------------- Mapping Cache ----------------- */
+
+void* mem_ems_map(uint16_t handle, uint16_t logical_page) {
+    mem_address_t page;
+    if (!mem_ems_frame) {
+        mem_ems_frame = mem_ems_page_frame();
+        if (!mem_ems_frame) {
+            return NULL;
+        }
+    }
+    page.segoff.segment = mem_ems_frame;
+    for (uint8_t i = 0; i < MEM_EMS_PHYSICAL_PAGES; ++i) {
+        if (mem_ems_cache[i].valid && mem_ems_cache[i].handle == handle && mem_ems_cache[i].logical_page == logical_page) {
+            page.segoff.offset = (uint16_t)i * MEM_EMS_PAGE_SIZE;
+            return page.ptr;
+        }
+    }
+    uint8_t slot = mem_ems_victim;
+    mem_ems_victim = (mem_ems_victim + 1) % MEM_EMS_PHYSICAL_PAGES;
+    ++mem_ems_misses;
+    if (mem_ems_map_page(handle, slot, logical_page)) {
+        mem_ems_cache[slot].valid = false;
+        return NULL;
+    }
+    mem_ems_cache[slot].handle = handle;
+    mem_ems_cache[slot].logical_page = logical_page;
+    mem_ems_cache[slot].valid = true;
+    page.segoff.offset = (uint16_t)slot * MEM_EMS_PAGE_SIZE;
+    return page.ptr;
+}
+
+uint32_t mem_ems_cache_misses() {
+    return mem_ems_misses;
+}
+
+/** @} */ // end of memory_ems_impl group
@@ -0,0 +1,148 @@
+/**
+ * @file mem_ems.h
+ * @brief LIM EMS 4.0 expanded memory services (INT 67h) with a page-mapping cache
+ * @defgroup memory_ems Expanded Memory
+ * @{
+ */
+#ifndef MEM_EMS_H
+#define MEM_EMS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mem_constants.h"
+
+/* ----------------- Driver ----------------- */
+
+/**
+ * @brief Detects an expanded memory manager
+ * @return true if the INT 67h handler's device header is named "EMMXXXX0"
+ *
+ * @note Must be checked before any other EMS call - INT 67h is not
+ *       guaranteed to point anywhere sensible without a driver
+ */
+bool mem_ems_present();
+
+/**
+ * @brief Gets the manager status
+ * @return 0 if the hardware and driver are working, else the EMS error code
+ *
+ * @asm
+ *   INT 67,40 - Get Status
+ *   AH = 40h
+ *   Returns:
+ *   AH = status (0 = ok)
+ * @endasm
+ */
+uint8_t mem_ems_status();
+
+/**
+ * @brief Gets the segment of the 64KB page frame
+ * @return Page frame segment or 0 on error
+ *
+ * @asm
+ *   INT 67,41 - Get Page Frame Address
+ *   AH = 41h
+ *   Returns:
+ *   AH = status
+ *   BX = page frame segment
+ * @endasm
+ */
+uint16_t mem_ems_page_frame();
+
+/**
+ * @brief Gets the number of unallocated 16KB pages
+ * @return Free pages or 0 on error
+ *
+ * @asm
+ *   INT 67,42 - Get Page Counts
+ *   AH = 42h
+ *   Returns:
+ *   AH = status
+ *   BX = unallocated pages
+ *   DX = total pages
+ * @endasm
+ */
+uint16_t mem_ems_free_pages();
+
+/* ----------------- Handles ----------------- */
+
+/**
+ * @brief Allocates logical pages under a new handle
+ * @param pages Number of 16KB pages
+ * @param[out] handle EMS handle on success
+ * @return 0 on success, else the EMS error code
+ *
+ * @asm
+ *   INT 67,43 - Allocate Pages
+ *   AH = 43h
+ *   BX = number of logical pages
+ *   Returns:
+ *   AH = status
+ *   DX = handle
+ * @endasm
+ */
+uint8_t mem_ems_allocate_pages(uint16_t pages, uint16_t* handle);
+
+/**
+ * @brief Maps a logical page of a handle into a physical page of the frame
+ * @param handle EMS handle
+ * @param physical_page 0 - 3
+ * @param logical_page Page within the handle
+ * @return 0 on success, else the EMS error code
+ *
+ * @asm
+ *   INT 67,44 - Map Logical Page
+ *   AH = 44h
+ *   AL = physical page
+ *   BX = logical page
+ *   DX = handle
+ *   Returns:
+ *   AH = status
+ * @endasm
+ *
+ * @warning Bypasses the mapping cache - prefer mem_ems_map()
+ */
+uint8_t mem_ems_map_page(uint16_t handle, uint8_t physical_page, uint16_t logical_page);
+
+/**
+ * @brief Releases a handle and all its pages
+ * @param handle EMS handle
+ * @return 0 on success, else the EMS error code
+ *
+ * @asm
+ *   INT 67,45 - Release Pages
+ *   AH = 45h
+ *   DX = handle
+ *   Returns:
+ *   AH = status
+ * @endasm
+ *
+ * @note Also drops the handle's pages from the mapping cache
+ */
+uint8_t mem_ems_release_pages(uint16_t handle);
+
+/* ----------------- Mapping Cache ----------------- */
+
+/**
+ * @brief Makes a logical page addressable, re-mapping only on a cache miss
+ * @param handle EMS handle
+ * @param logical_page Page within the handle
+ * @return Far pointer to the start of the page in the frame or NULL on error
+ *
+ * @details The four physical pages act as a fully associative cache of
+ *          (handle, logical page) pairs, replaced round-robin. Repeated probes
+ *          to the same 16KB page cost a table scan rather than an INT 67h.
+ *
+ * @warning A pointer stays valid only until four other pages have been mapped
+ */
+void* mem_ems_map(uint16_t handle, uint16_t logical_page);
+
+/**
+ * @brief Gets the number of mem_ems_map() calls that had to call INT 67h
+ * @return Cache misses since start up
+ */
+uint32_t mem_ems_cache_misses();
+
+#endif
+/** @} */ // end of memory_ems group
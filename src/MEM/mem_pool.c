@@ -0,0 +1,125 @@
+/**
+ * @file mem_pool.c
+ * @brief Fixed-size object pool implementation
+ * @defgroup memory_pool_impl Memory Pool Internals
+ * @{
+ */
+#include <stdio.h>
+#include <assert.h>
+#include <memory.h>
+
+#include "mem_pool.h"
+
+/* ----------------- Pool Structure ----------------- */
+
+/**
+ * @brief Free slot overlay - the link lives inside the released slot
+ */
+typedef struct private_mem_pool_slot_t {
+    struct private_mem_pool_slot_t* next;   ///< Next free slot or NULL
+} mem_pool_slot_t;
+
+/**
+ * @brief Internal pool representation
+ */
+typedef struct private_mem_pool_t {
+    mem_arena_t* arena;     ///< Backing arena for fresh slots
+    mem_size_t slot_size;   ///< Bytes per slot (>= sizeof(mem_pool_slot_t))
+    mem_pool_slot_t* free;  ///< Head of the intrusive free list
+    mem_size_t live;        ///< Slots handed out
+    mem_size_t carved;      ///< Slots taken from the arena
+} mem_pool_t;
+
+/* ----------------- Public Interface ----------------- */
+
+mem_pool_t* mem_pool_create(mem_arena_t* arena, mem_size_t slot_size) {
+    assert(arena);
+    assert(slot_size);
+    assert(mem_arena_policy(arena) != MEM_ARENA_POLICY_EMS && "EMS memory has no real-mode address!");
+    if (mem_arena_policy(arena) == MEM_ARENA_POLICY_EMS) {
+        return NULL;
+    }
+    mem_pool_t* pool = (mem_pool_t*)mem_arena_alloc(arena, sizeof(mem_pool_t));
+    if (!pool) {
+        return NULL;
+    }
+    pool->arena = arena;
+    pool->slot_size = (slot_size < sizeof(mem_pool_slot_t)) ? sizeof(mem_pool_slot_t) : slot_size;
+    pool->free = NULL;
+    pool->live = 0;
+    pool->carved = 0;
+    return pool;
+}
+
+void* mem_pool_alloc(mem_pool_t* pool) {
+    assert(pool);
+    mem_pool_slot_t* slot = pool->free;
+    if (slot) {
+        pool->free = slot->next;
+    }
+    else {
+        slot = (mem_pool_slot_t*)mem_arena_alloc(pool->arena, pool->slot_size);
+        if (!slot) {
+            return NULL;
+        }
+        ++pool->carved;
+    }
+    ++pool->live;
+    return slot;
+}
+
+void* mem_pool_calloc(mem_pool_t* pool) {
+    void* ptr = mem_pool_alloc(pool);
+    if (ptr) {
+        memset(ptr, 0, pool->slot_size);
+    }
+    return ptr;
+}
+
+void mem_pool_free(mem_pool_t* pool, void* ptr) {
+    assert(pool);
+    if (!ptr) {
+        return;
+    }
+    assert(pool->live && "FREE without matching alloc!");
+    mem_pool_slot_t* slot = (mem_pool_slot_t*)ptr;
+    slot->next = pool->free;
+    pool->free = slot;
+    --pool->live;
+}
+
+/* ----------------- Accessors ----------------- */
+
+mem_size_t mem_pool_slot_size(mem_pool_t* pool) {
+    return pool->slot_size;
+}
+
+mem_size_t mem_pool_live_count(mem_pool_t* pool) {
+    return pool->live;
+}
+
+mem_size_t mem_pool_carved_count(mem_pool_t* pool) {
+    return pool->carved;
+}
+
+/* ----------------- Debugging ----------------- */
+
+void mem_pool_dump(FILE* output_stream, mem_pool_t* pool) {
+    if (!output_stream || !pool) return;
+
+    fprintf(output_stream,
+           "\nPool @%p\n"
+           "Arena: %p\n"
+           "Slot size: %lu bytes\n"
+           "Live: %lu slots\n"
+           "Carved: %lu slots\n",
+           pool,
+           pool->arena,
+           pool->slot_size,
+           pool->live,
+           pool->carved);
+
+    fflush(output_stream);
+}
+
+/** @} */ // end of memory_pool_impl group
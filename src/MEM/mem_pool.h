@@ -0,0 +1,105 @@
+/**
+ * @file mem_pool.h
+ * @brief Fixed-size object pool carved from a memory arena
+ * @defgroup memory_pool Memory Pool
+ * @{
+ */
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include <stdio.h>
+
+#include "mem_arena.h"
+#include "mem_types.h"
+
+/* ----------------- Pool Structure ----------------- */
+
+/**
+ * @brief Opaque object pool handle
+ * @dot
+ * digraph pool {
+ *     node [shape=record, fontname="Courier New"];
+ *     pool [label="<f0> Arena|<f1> Slot Size|<f2> Free List|<f3> Live|<f4> Carved"];
+ * }
+ * @enddot
+ *
+ * @details Released slots are chained through their own first bytes
+ *          (an intrusive free list) so the pool has no per-slot overhead.
+ *          Fresh slots are carved from the arena only when the free list is empty.
+ *
+ * @warning Contents are private - use accessor functions
+ */
+typedef struct private_mem_pool_t mem_pool_t;
+
+/* ----------------- Core Operations ----------------- */
+
+/**
+ * @brief Creates a pool of equal-sized slots inside an arena
+ * @param arena Valid arena handle - the pool header is allocated from it too
+ * @param slot_size Object size in bytes (rounded up to hold a pointer)
+ * @return Pool handle or NULL if the arena is full
+ *
+ * @note The pool lives as long as the arena (or until rewound past)
+ */
+mem_pool_t* mem_pool_create(mem_arena_t* arena, mem_size_t slot_size);
+
+/**
+ * @brief Allocates one slot
+ * @param pool Valid pool handle
+ * @return Pointer to slot_size bytes or NULL if the arena is full
+ *
+ * @details O(1): pops the free list, otherwise carves from the arena
+ */
+void* mem_pool_alloc(mem_pool_t* pool);
+
+/**
+ * @brief Allocates one zero-initialized slot
+ * @param pool Valid pool handle
+ * @return Pointer to zeroed slot or NULL if the arena is full
+ */
+void* mem_pool_calloc(mem_pool_t* pool);
+
+/**
+ * @brief Returns a slot to the pool
+ * @param pool Pool the slot came from
+ * @param ptr Slot from mem_pool_alloc() (NULL is ignored)
+ *
+ * @details O(1): pushes the slot onto the free list
+ * @warning ptr must not be used after this call
+ */
+void mem_pool_free(mem_pool_t* pool, void* ptr);
+
+/* ----------------- Accessors ----------------- */
+
+/**
+ * @brief Gets the rounded slot size
+ * @param pool Valid pool handle
+ * @return Bytes per slot
+ */
+mem_size_t mem_pool_slot_size(mem_pool_t* pool);
+
+/**
+ * @brief Gets the number of slots currently handed out
+ * @param pool Valid pool handle
+ * @return Allocated minus freed slots
+ */
+mem_size_t mem_pool_live_count(mem_pool_t* pool);
+
+/**
+ * @brief Gets the number of slots ever carved from the arena
+ * @param pool Valid pool handle
+ * @return Live plus free-listed slots
+ */
+mem_size_t mem_pool_carved_count(mem_pool_t* pool);
+
+/* ----------------- Debugging ----------------- */
+
+/**
+ * @brief Dumps pool metadata to stream
+ * @param output_stream File/console output
+ * @param pool Valid pool handle
+ */
+void mem_pool_dump(FILE* output_stream, mem_pool_t* pool);
+
+#endif
+/** @} */ // end of memory_pool group
@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "../DOS/dos_services_files.h"
+#include "mem_constants.h"
 
 uint16_t mem_max_paragraphs() {
     uint16_t paragraphs, err_code;
@@ -32,6 +33,27 @@ mem_diff_t mem_diff_pointers(const void* p1, const void* p2) {
     return (mem_diff_t)(addr1 - addr2);
 }
 
+uint32_t mem_linear_address(const void* ptr) {
+    mem_address_t address;
+    address.ptr = (char*)ptr;
+    return ((uint32_t)address.segoff.segment << 4) + address.segoff.offset;
+}
+
+void* mem_linear_to_pointer(uint32_t linear) {
+    mem_address_t address;
+    address.segoff.segment = (uint16_t)(linear >> 4);
+    address.segoff.offset = (uint16_t)(linear & (MEM_SIZE_PARAGRAPH - 1));
+    return address.ptr;
+}
+
+void* mem_normalize_pointer(const void* ptr) {
+    return mem_linear_to_pointer(mem_linear_address(ptr));
+}
+
+mem_diff_t mem_diff_linear(const void* p1, const void* p2) {
+    return (mem_diff_t)(mem_linear_address(p1) - mem_linear_address(p2));
+}
+
 void mem_dump_mcb_to_stream( FILE* stream, const char* mcb) {
     assert(mcb != NULL);
     assert(stream != NULL);
@@ -78,3 +100,51 @@ dos_file_size_t mem_save_to_file(const char* path_name, char* start, uint16_t nb
     }
     return bytes_saved;
 }
+
+uint16_t mem_file_chunks(dos_file_size_t nbytes) {
+    return (uint16_t)((nbytes / MEM_FILE_CHUNK_SIZE) + ((nbytes % MEM_FILE_CHUNK_SIZE) ? 1 : 0));
+}
+
+dos_file_size_t mem_load_huge_from_file(const char* path_name, char* start, dos_file_size_t nbytes, tdd_progress_t* progress) {
+    assert(path_name && strlen(path_name) > 0 && start && nbytes);
+    dos_file_handle_t fhandle = dos_open_file(path_name, ACCESS_READ_ONLY);
+    dos_file_size_t bytes_loaded = 0;
+    if (fhandle) {
+        uint32_t linear = mem_linear_address(start);
+        while (bytes_loaded < nbytes) {
+            uint16_t chunk = (nbytes - bytes_loaded < MEM_FILE_CHUNK_SIZE) ? (uint16_t)(nbytes - bytes_loaded) : MEM_FILE_CHUNK_SIZE;
+            uint16_t n = dos_read_file(fhandle, (char*)mem_linear_to_pointer(linear + bytes_loaded), chunk);
+            bytes_loaded += n;
+            if (progress && progress->current < progress->total) {
+                tdd_progress_bar(progress);
+            }
+            if (n < chunk) {
+                break;      // end of file
+            }
+        }
+        dos_close_file(fhandle);
+    }
+    return bytes_loaded;
+}
+
+dos_file_size_t mem_save_huge_to_file(const char* path_name, char* start, dos_file_size_t nbytes, tdd_progress_t* progress) {
+    assert(path_name && strlen(path_name) > 0 && start && nbytes);
+    dos_file_size_t bytes_saved = 0;
+    dos_file_handle_t fhandle = dos_create_file(path_name, CREATE_READ_WRITE);
+    if (fhandle) {
+        uint32_t linear = mem_linear_address(start);
+        while (bytes_saved < nbytes) {
+            uint16_t chunk = (nbytes - bytes_saved < MEM_FILE_CHUNK_SIZE) ? (uint16_t)(nbytes - bytes_saved) : MEM_FILE_CHUNK_SIZE;
+            uint16_t n = dos_write_file(fhandle, (char*)mem_linear_to_pointer(linear + bytes_saved), chunk);
+            bytes_saved += n;
+            if (progress && progress->current < progress->total) {
+                tdd_progress_bar(progress);
+            }
+            if (n < chunk) {
+                break;      // disk full
+            }
+        }
+        dos_close_file(fhandle);
+    }
+    return bytes_saved;
+}
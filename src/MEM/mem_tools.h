@@ -11,6 +11,7 @@
 #include <stdio.h>
 
 #include "../DOS/dos_services_files_types.h"
+#include "../TDD/tdd_progress.h"
 
 #include "mem_types.h"
 
@@ -55,6 +56,42 @@ uint16_t mem_max_paragraphs();
  */
 mem_diff_t mem_diff_pointers(const void* p1, const void* p2);
 
+/* ----------------- Linear Addressing ----------------- */
+
+/**
+ * @brief Converts a segment:offset pointer to its 20-bit physical address
+ * @param ptr Far pointer
+ * @return (segment << 4) + offset
+ */
+uint32_t mem_linear_address(const void* ptr);
+
+/**
+ * @brief Converts a physical address to a normalized far pointer
+ * @param linear 20-bit physical address
+ * @return Pointer with segment = linear >> 4 and offset = linear & 0Fh
+ *
+ * @note A normalized pointer can be advanced by up to FFF0h bytes
+ *       without its offset wrapping
+ */
+void* mem_linear_to_pointer(uint32_t linear);
+
+/**
+ * @brief Normalizes a far pointer so its offset is below 16
+ * @param ptr Far pointer
+ * @return Same physical address as a normalized pointer
+ */
+void* mem_normalize_pointer(const void* ptr);
+
+/**
+ * @brief Calculates the physical byte difference between two far pointers
+ * @param p1 First address
+ * @param p2 Second address
+ * @return Signed difference in bytes (p1 - p2)
+ *
+ * @note Unlike mem_diff_pointers() the pointers may be in different segments
+ */
+mem_diff_t mem_diff_linear(const void* p1, const void* p2);
+
 /**
  * @brief Dumps Memory Control Block (MCB) information to a specified stream
  * @param[in] mcb Pointer to the Memory Control Block
@@ -125,6 +162,43 @@ dos_file_size_t mem_load_from_file(const char* path_name, char* start, uint16_t
  */
 dos_file_size_t mem_save_to_file(const char* path_name, char* start, uint16_t nbytes);
 
+/**
+ * @brief Number of MEM_FILE_CHUNK_SIZE pieces needed for nbytes
+ * @param[in] nbytes Bytes to load or save
+ * @return Chunk count - the total for a tdd_progress_t passed to the huge load/save
+ */
+uint16_t mem_file_chunks(dos_file_size_t nbytes);
+
+/**
+ * @brief Loads a file of any size into memory spanning segments (e.g. a huge arena)
+ * @param[in] path_name File to load (must be non-empty)
+ * @param[out] start Destination memory address
+ * @param[in] nbytes Maximum bytes to load (must be >0)
+ * @param[in,out] progress Advanced once per chunk, or NULL
+ * @return Actual bytes loaded (dos_file_size_t)
+ *
+ * @details Loops dos_read_file in MEM_FILE_CHUNK_SIZE pieces, re-normalizing
+ *          the destination before each so no read wraps at a 64KB offset
+ *
+ * @code
+ * tdd_progress_t progress = tdd_progress_make(mem_file_chunks(n), 0, mem_file_chunks(n), 20);
+ * mem_load_huge_from_file("KPK.BIT", mem_arena_alloc(huge, n), n, &progress);
+ * @endcode
+ * @see mem_save_huge_to_file()
+ */
+dos_file_size_t mem_load_huge_from_file(const char* path_name, char* start, dos_file_size_t nbytes, tdd_progress_t* progress);
+
+/**
+ * @brief Saves memory spanning segments to a file, creating or truncating it
+ * @param[in] path_name Destination file (must be non-empty)
+ * @param[in] start Source memory address
+ * @param[in] nbytes Bytes to save (must be >0)
+ * @param[in,out] progress Advanced once per chunk, or NULL
+ * @return Actual bytes saved (dos_file_size_t)
+ *
+ * @see mem_load_huge_from_file()
+ */
+dos_file_size_t mem_save_huge_to_file(const char* path_name, char* start, dos_file_size_t nbytes, tdd_progress_t* progress);
 
 #endif
 
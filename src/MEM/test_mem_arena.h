@@ -12,6 +12,7 @@
 #include "mem_arena.h"
 #include "../TDD/tdd_macros.h"
 #include "mem_tools.h"
+#include "../TDD/tdd_report.h"
 
 /// @brief Array of all test cases for the arena library
 #define ARENA_TESTS &test_arena_creation, \
@@ -20,6 +21,13 @@
                     &test_deallocation, \
                     &test_zero_allocation, \
                     &test_null_arena_handling, \
+                    &test_arena_mark_rewind, \
+                    &test_arena_scope, \
+                    &test_aligned_allocation, \
+                    &test_sub_arena, \
+                    &test_huge_arena, \
+                    &test_arena_stats, \
+                    &test_chained_arena, \
                     &test_arena_dump
 
 #define TEST_ARENA_SIZE (MEM_SIZE_1K)  // 1KB test arena
@@ -137,6 +145,177 @@ TEST(test_null_arena_handling) {
 #endif
 }
 
+/* ----------------- Save Point Tests ----------------- */
+
+TEST(test_arena_mark_rewind) {
+    setup();
+
+    mem_arena_alloc(test_arena, 32);
+    mem_arena_mark_t outer = mem_arena_mark(test_arena);
+    char* scratch = (char*)mem_arena_alloc(test_arena, 100);
+    mem_arena_mark_t inner = mem_arena_mark(test_arena);
+    mem_arena_alloc(test_arena, 200);
+
+    // Marks nest like a stack
+    ASSERT(mem_arena_rewind(test_arena, inner) == 200);
+    ASSERT(mem_arena_used(test_arena) == 132);
+    ASSERT(mem_arena_rewind(test_arena, outer) == 100);
+    ASSERT(mem_arena_used(test_arena) == 32);
+
+    // Space is reused from the mark
+    ASSERT((char*)mem_arena_alloc(test_arena, 100) == scratch);
+
+    teardown();
+}
+
+TEST(test_arena_scope) {
+    setup();
+
+    mem_arena_alloc(test_arena, 16);
+    MEM_ARENA_SCOPE(test_arena) {
+        ASSERT(mem_arena_alloc(test_arena, 512) != NULL);
+        ASSERT(mem_arena_used(test_arena) == 528);
+    }
+    ASSERT(mem_arena_used(test_arena) == 16);
+
+    teardown();
+}
+
+/* ----------------- Alignment Tests ----------------- */
+
+TEST(test_aligned_allocation) {
+    setup();
+
+    mem_address_t address;
+    mem_arena_alloc(test_arena, 3);
+    address.ptr = (char*)mem_arena_alloc_aligned(test_arena, 8, 2);
+    ASSERT(address.ptr != NULL);
+    ASSERT((address.segoff.offset & 1) == 0);
+    ASSERT(mem_arena_used(test_arena) == 12);  // one byte of padding
+
+    address.ptr = (char*)mem_arena_alloc_aligned(test_arena, 1, MEM_SIZE_PARAGRAPH);
+    ASSERT((address.segoff.offset & (MEM_SIZE_PARAGRAPH - 1)) == 0);
+
+    // Padding that does not fit fails instead of returning misaligned memory
+    mem_arena_alloc(test_arena, mem_arena_size(test_arena) - 2);
+    ASSERT(mem_arena_alloc_aligned(test_arena, 2, 4) == NULL);
+    ASSERT(mem_arena_size(test_arena) == 2);
+    ASSERT(mem_arena_alloc_aligned(test_arena, 2, 2) != NULL);
+
+    teardown();
+}
+
+TEST(test_sub_arena) {
+    setup();
+
+    mem_address_t address;
+    mem_arena_alloc(test_arena, 5);
+    mem_arena_t* child = mem_arena_create_sub(test_arena, 100);
+    ASSERT(child != NULL);
+    ASSERT(mem_arena_policy(child) == MEM_ARENA_POLICY_SUB);
+    ASSERT(mem_arena_capacity(child) == 112);  // whole paragraphs
+
+    // Child starts at offset 0 of its own segment
+    address.ptr = (char*)mem_arena_base_address(child);
+    ASSERT(address.segoff.offset == 0);
+    address.ptr = (char*)mem_arena_alloc(child, 10);
+    ASSERT(address.segoff.offset == 0);
+
+    ASSERT(mem_arena_delete(child) == 112);
+    ASSERT(mem_arena_used(test_arena) == 16 + 112);
+
+    teardown();
+}
+
+/* ----------------- Huge Arena Tests ----------------- */
+
+TEST(test_huge_arena) {
+    mem_arena_t* huge = mem_arena_create(MEM_ARENA_POLICY_HUGE, 131072UL);
+    ASSERT(huge != NULL);
+    ASSERT(mem_arena_capacity(huge) == 131072UL);
+
+    // Allocations past 64KB come back normalized, never straddling a segment
+    mem_address_t blocks[3];
+    for (uint8_t i = 0; i < 3; ++i) {
+        blocks[i].ptr = (char*)mem_arena_alloc(huge, 40000U);
+        ASSERT(blocks[i].ptr != NULL);
+        ASSERT(blocks[i].segoff.offset < MEM_SIZE_PARAGRAPH);
+    }
+    ASSERT(mem_arena_used(huge) == 120000UL);
+    ASSERT(mem_diff_linear(blocks[2].ptr, blocks[0].ptr) == 80000L);
+
+    // Last byte of one block is just before the next
+    blocks[0].ptr[39999U] = 'X';
+    ASSERT(*(char*)mem_linear_to_pointer(mem_linear_address(blocks[1].ptr) - 1) == 'X');
+
+    // Single blocks are limited to one segment
+    ASSERT(mem_arena_alloc(huge, MEM_HUGE_MAX_ALLOCATE + 1UL) == NULL);
+
+    mem_arena_delete(huge);
+}
+
+/* ----------------- Chained Arena Tests ----------------- */
+
+TEST(test_chained_arena) {
+    mem_arena_t* chain = mem_arena_create(MEM_ARENA_POLICY_CHAINED, TEST_ARENA_SIZE);
+    ASSERT(chain != NULL);
+    ASSERT(mem_arena_capacity(chain) == TEST_ARENA_SIZE);
+
+    char* first = (char*)mem_arena_alloc(chain, 1000);
+    mem_arena_mark_t mark = mem_arena_mark(chain);
+
+    // Running out links a second, larger block instead of failing
+    char* second = (char*)mem_arena_alloc(chain, 1000);
+    ASSERT(first != NULL && second != NULL);
+    ASSERT(mem_arena_capacity(chain) > 2 * TEST_ARENA_SIZE);
+    ASSERT(mem_arena_used(chain) >= 2000);
+    ASSERT(second == (char*)mem_arena_base_address(chain));  // start of the new block
+
+    // Rewinding past the link frees the second block
+    mem_arena_rewind(chain, mark);
+    ASSERT(mem_arena_capacity(chain) == TEST_ARENA_SIZE);
+    ASSERT(mem_arena_used(chain) == 1000);
+
+    // Requests larger than any block still fail
+    ASSERT(mem_arena_alloc(chain, MEM_SIZE_64K) == NULL);
+
+    ASSERT(mem_arena_delete(chain) == TEST_ARENA_SIZE);
+}
+
+/* ----------------- Instrumentation Tests ----------------- */
+
+TEST(test_arena_stats) {
+    setup();
+
+    const mem_arena_stats_t* stats = mem_arena_stats(test_arena);
+#ifdef MEM_ARENA_STATS
+    ASSERT(stats != NULL);
+    mem_arena_alloc_tagged(test_arena, 100, "tt");
+    mem_arena_alloc_tagged(test_arena, 50, "widgets");
+    mem_arena_alloc_tagged(test_arena, 20, "tt");
+    mem_arena_rewind(test_arena, mem_arena_mark(test_arena));
+    mem_arena_dealloc(test_arena, 170);
+    ASSERT(mem_arena_alloc(test_arena, TEST_ARENA_SIZE + 1) == NULL);
+
+    ASSERT(stats->peak == 170);         // survives the release
+    ASSERT(stats->allocations == 3);
+    ASSERT(stats->failures == 1);
+    ASSERT(stats->tag_count == 2);
+    ASSERT(stats->tags[0].bytes == 120 && stats->tags[0].count == 2);
+
+    tdd_report_metric(stdout, "test_arena", "peak", stats->peak);
+    tdd_report_metric(stdout, "test_arena", "allocations", stats->allocations);
+    tdd_report_metric(stdout, "test_arena", "failures", stats->failures);
+    for (uint8_t i = 0; i < stats->tag_count; ++i) {
+        tdd_report_metric(stdout, "test_arena", stats->tags[i].tag, stats->tags[i].bytes);
+    }
+#else
+    ASSERT(stats == NULL);
+#endif
+
+    teardown();
+}
+
 /* ----------------- Main Test Runner ----------------- */
 
 TEST(test_arena_dump) {
@@ -0,0 +1,74 @@
+/**
+ * @file test_mem_ems.h
+ * @brief Test-driven development for expanded memory and EMS arenas
+ * @defgroup ems_tests Expanded Memory Tests
+ * @{
+ * @note Needs an EMM driver (e.g. an emulator with EMS enabled) - skipped otherwise
+ */
+#ifndef TEST_MEM_EMS_H
+#define TEST_MEM_EMS_H
+
+#include <stdio.h>
+#include "mem_arena.h"
+#include "mem_ems.h"
+#include "../TDD/tdd_macros.h"
+
+/// @brief Array of all test cases for the EMS library
+#define EMS_TESTS &test_ems_cache, \
+                  &test_ems_arena
+
+TEST(test_ems_cache) {
+    if (!mem_ems_present()) {
+        V(printf("No EMS driver - skipped\n"););
+        return;
+    }
+    ASSERT(mem_ems_status() == 0);
+    ASSERT(mem_ems_page_frame() != 0);
+
+    uint16_t handle;
+    ASSERT(mem_ems_allocate_pages(2, &handle) == 0);
+
+    char* page0 = (char*)mem_ems_map(handle, 0);
+    ASSERT(page0 != NULL);
+    page0[0] = 'A';
+    char* page1 = (char*)mem_ems_map(handle, 1);
+    page1[0] = 'B';
+
+    // Repeated probes to mapped pages do not re-map
+    uint32_t misses = mem_ems_cache_misses();
+    ASSERT(mem_ems_map(handle, 0) == page0);
+    ASSERT(mem_ems_map(handle, 1) == page1);
+    ASSERT(mem_ems_cache_misses() == misses);
+    ASSERT(page0[0] == 'A' && page1[0] == 'B');
+
+    ASSERT(mem_ems_release_pages(handle) == 0);
+}
+
+TEST(test_ems_arena) {
+    if (!mem_ems_present()) {
+        V(printf("No EMS driver - skipped\n"););
+        return;
+    }
+    mem_arena_t* ems = mem_arena_create(MEM_ARENA_POLICY_EMS, 4UL * MEM_EMS_PAGE_SIZE);
+    ASSERT(ems != NULL);
+    ASSERT(mem_arena_capacity(ems) == 4UL * MEM_EMS_PAGE_SIZE);
+
+    void* first = mem_arena_calloc(ems, 10000);
+    void* second = mem_arena_alloc(ems, 10000);    // would straddle - moves to page 1
+    ASSERT(first != NULL && second != NULL);
+    ASSERT(mem_arena_used(ems) == MEM_EMS_PAGE_SIZE + 10000UL);
+
+    char* data = (char*)mem_arena_ems_map(ems, second);
+    data[9999] = 'Z';
+    ASSERT(((char*)mem_arena_ems_map(ems, first))[9999] == 0);
+    ASSERT(((char*)mem_arena_ems_map(ems, second))[9999] == 'Z');
+
+    // Nothing larger than a page
+    ASSERT(mem_arena_alloc(ems, MEM_EMS_PAGE_SIZE + 1UL) == NULL);
+
+    ASSERT(mem_arena_delete(ems) == 4UL * MEM_EMS_PAGE_SIZE);
+}
+
+#endif
+
+/** @} */ // end of ems_tests group
@@ -0,0 +1,79 @@
+/**
+ * @file test_mem_pool.h
+ * @brief Test-driven development for the object pool
+ * @defgroup pool_tests Memory Pool Tests
+ * @{
+ */
+#ifndef TEST_MEM_POOL_H
+#define TEST_MEM_POOL_H
+
+#include <stdio.h>
+#include "mem_arena.h"
+#include "mem_pool.h"
+#include "../TDD/tdd_macros.h"
+
+/// @brief Array of all test cases for the pool library
+#define POOL_TESTS &test_pool_reuse, \
+                   &test_pool_small_slots, \
+                   &test_pool_exhaustion
+
+TEST(test_pool_reuse) {
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_C, MEM_SIZE_1K);
+    mem_pool_t* pool = mem_pool_create(arena, 24);
+    ASSERT(pool != NULL);
+
+    char* a = (char*)mem_pool_alloc(pool);
+    char* b = (char*)mem_pool_alloc(pool);
+    ASSERT(a && b && a != b);
+    ASSERT(mem_pool_live_count(pool) == 2);
+
+    // Freed slots come back before the arena is touched again
+    mem_size_t used = mem_arena_used(arena);
+    mem_pool_free(pool, a);
+    ASSERT(mem_pool_alloc(pool) == a);
+    ASSERT(mem_arena_used(arena) == used);
+    ASSERT(mem_pool_carved_count(pool) == 2);
+
+    // calloc zeroes a recycled slot
+    mem_pool_free(pool, b);
+    b = (char*)mem_pool_calloc(pool);
+    ASSERT(b[0] == 0 && b[23] == 0);
+
+    V(mem_pool_dump(stdout, pool););
+    mem_arena_delete(arena);
+}
+
+TEST(test_pool_small_slots) {
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_C, MEM_SIZE_1K);
+    mem_pool_t* pool = mem_pool_create(arena, 1);
+
+    // Slots must be able to hold the free list link
+    ASSERT(mem_pool_slot_size(pool) == sizeof(void*));
+
+    mem_arena_delete(arena);
+}
+
+TEST(test_pool_exhaustion) {
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_C, MEM_SIZE_1K);
+    mem_pool_t* pool = mem_pool_create(arena, 256);
+    void* slot = NULL;
+    void* last = NULL;
+    mem_size_t count = 0;
+
+    while ((slot = mem_pool_alloc(pool)) != NULL) {
+        last = slot;
+        ++count;
+    }
+    ASSERT(count == 3);  // the pool header takes part of the fourth slot
+    ASSERT(mem_pool_live_count(pool) == 3);
+
+    // A freed slot is still available once the arena is full
+    mem_pool_free(pool, last);
+    ASSERT(mem_pool_alloc(pool) == last);
+
+    mem_arena_delete(arena);
+}
+
+#endif
+
+/** @} */ // end of pool_tests group
@@ -14,11 +14,13 @@
 #include "../DOS/dos_services_files.h"
 
 #include "mem_tools.h"
+#include "mem_arena.h"
 
 #define TOOLS_TESTS &test_mem_max_paragraphs, \
                     &test_mem_diff_pointers, \
                     &test_mem_dump_mcb_to_stream, \
-                    &test_mem_load_save_file
+                    &test_mem_load_save_file, \
+                    &test_mem_load_save_huge_file
 
 /**
  * @brief Test memory availability query
@@ -83,4 +85,39 @@ TEST(test_mem_load_save_file) {
 
 }
 
+/**
+ * @brief Test chunked load/save across segment boundaries
+ * @details Tests:
+ * - Round-trip of 96KB through a huge arena
+ * - One progress step per 32KB chunk
+ * - Bytes either side of a 64KB boundary survive
+ */
+TEST(test_mem_load_save_huge_file) {
+    const dos_file_size_t nbytes = 3UL * MEM_FILE_CHUNK_SIZE;
+    mem_arena_t* huge = mem_arena_create(MEM_ARENA_POLICY_HUGE, nbytes);
+    ASSERT(huge != NULL);
+    char* data = (char*)mem_arena_base_address(huge);
+    uint32_t linear = mem_linear_address(data);
+    for (dos_file_size_t i = 0; i < nbytes; i += 4096) {
+        *(char*)mem_linear_to_pointer(linear + i) = (char)(i >> 12);
+    }
+    *(char*)mem_linear_to_pointer(linear + 65535UL) = 'L';
+    *(char*)mem_linear_to_pointer(linear + 65536UL) = 'H';
+
+    EXPECT_EQ(mem_file_chunks(nbytes), 3);
+    tdd_progress_t progress = tdd_progress_make(mem_file_chunks(nbytes), 0, mem_file_chunks(nbytes), 20);
+    EXPECT_EQ(mem_save_huge_to_file("HUGE.TMP", data, nbytes, &progress), nbytes);
+    EXPECT_EQ(progress.current, 3);
+
+    *(char*)mem_linear_to_pointer(linear + 65535UL) = 0;
+    *(char*)mem_linear_to_pointer(linear + 65536UL) = 0;
+    EXPECT_EQ(mem_load_huge_from_file("HUGE.TMP", data, nbytes, NULL), nbytes);
+    EXPECT(*(char*)mem_linear_to_pointer(linear + 65535UL) == 'L');
+    EXPECT(*(char*)mem_linear_to_pointer(linear + 65536UL) == 'H');
+    EXPECT(*(char*)mem_linear_to_pointer(linear + 20480UL) == 5);
+
+    dos_delete_file("HUGE.TMP");
+    mem_arena_delete(huge);
+}
+
 #endif
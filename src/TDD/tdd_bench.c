@@ -0,0 +1,125 @@
+#include "tdd_bench.h"
+#include "tdd_graphs.h"
+
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__WATCOMC__) && !defined(__386__)
+#include "../BIOS/bios_pit_timer.h"
+#include "../BIOS/bios_timer_io_constants.h"
+#define TDD_BENCH_PIT
+#endif
+
+volatile uint32_t tdd_bench_sink = 0;
+
+static void private_tdd_bench_empty_fn(uint32_t _iterations) {
+    BENCH_LOOP {
+        TDD_BENCH_KEEP(_i);
+    }
+}
+
+uint64_t tdd_bench_now() {
+#ifdef TDD_BENCH_PIT
+    return bios_pit_timer_read();
+#else
+    return (uint64_t)clock();
+#endif
+}
+
+uint32_t tdd_bench_ticks_per_second() {
+#ifdef TDD_BENCH_PIT
+    return BIOS_PIT_FREQUENCY;
+#else
+    return (uint32_t)CLOCKS_PER_SEC;
+#endif
+}
+
+void tdd_bench_begin() {
+#ifdef TDD_BENCH_PIT
+    bios_pit_timer_init();
+#endif
+}
+
+void tdd_bench_end() {
+#ifdef TDD_BENCH_PIT
+    bios_pit_timer_restore();
+#endif
+}
+
+static uint64_t private_tdd_bench_time(void (*fn)(uint32_t), uint32_t iterations) {
+    uint64_t start = tdd_bench_now();
+    fn(iterations);
+    return tdd_bench_now() - start;
+}
+
+static double private_tdd_bench_ns(uint64_t ticks, uint32_t iterations) {
+    return (double)ticks * 1.0e9 / tdd_bench_ticks_per_second() / iterations;
+}
+
+uint8_t tdd_bench_bucket(uint64_t ticks) {
+    uint8_t bucket = 0;
+    while (ticks && bucket < TDD_BENCH_BUCKETS - 1) {
+        ticks >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+static void private_tdd_bench_histogram(const bench_t* bench, tdd_bench_result_t* result) {
+    uint64_t overhead = UINT64_MAX;
+    for (uint8_t i = 0; i < 16; ++i) {      // cheapest empty call - the cost of reading the timer
+        uint64_t t = private_tdd_bench_time(private_tdd_bench_empty_fn, 1);
+        if (t < overhead) overhead = t;
+    }
+    memset(result->histogram, 0, sizeof(result->histogram));
+    for (uint16_t r = 0; r < TDD_BENCH_HISTOGRAM_RUNS; ++r) {
+        uint64_t t = private_tdd_bench_time(bench->fn, 1);
+        result->histogram[tdd_bench_bucket((t > overhead) ? t - overhead : 0)]++;
+    }
+    result->bucket_ns = 1.0e9 / tdd_bench_ticks_per_second();
+}
+
+void tdd_bench_plot(const tdd_bench_result_t* result) {
+    assert(result && "NULL result!");
+    tdd_size_t first = 0;
+    tdd_size_t last = TDD_BENCH_BUCKETS;
+    while (first < TDD_BENCH_BUCKETS && !result->histogram[first]) ++first;
+    while (last > first && !result->histogram[last - 1]) --last;
+    if (first == last) {
+        return;
+    }
+    printf("%s: bucket %lu starts at %.0f ns, each doubles\n",
+           result->name, (unsigned long)first, (first) ? result->bucket_ns * (1UL << (first - 1)) : 0.0);
+    tdd_histogram(&result->histogram[first], last - first, TDD_BENCH_HISTOGRAM_WIDTH);
+}
+
+void tdd_bench_run(const bench_t* bench, tdd_bench_result_t* result) {
+    assert(bench && "NULL benchmark!");
+    assert(result && "NULL result!");
+    const uint64_t target = (uint64_t)TDD_BENCH_TARGET_US * tdd_bench_ticks_per_second() / 1000000UL;
+    uint32_t iterations = 1;
+    while (private_tdd_bench_time(bench->fn, iterations) < target && iterations < TDD_BENCH_MAX_ITERATIONS) {
+        iterations <<= 1;       // calibrate - doubling until one sample reaches the target
+    }
+
+    double samples[TDD_BENCH_SAMPLES];
+    for (uint8_t s = 0; s < TDD_BENCH_SAMPLES; ++s) {
+        uint64_t empty = private_tdd_bench_time(private_tdd_bench_empty_fn, iterations);
+        uint64_t ticks = private_tdd_bench_time(bench->fn, iterations);
+        samples[s] = (ticks > empty) ? private_tdd_bench_ns(ticks - empty, iterations) : 0.0;
+        for (uint8_t j = s; j > 0 && samples[j - 1] > samples[j]; --j) {   // insertion sort
+            double t = samples[j];
+            samples[j] = samples[j - 1];
+            samples[j - 1] = t;
+        }
+    }
+
+    result->name = bench->name;
+    result->iterations = iterations;
+    result->samples = TDD_BENCH_SAMPLES;
+    result->min_ns = samples[0];
+    result->median_ns = samples[TDD_BENCH_SAMPLES / 2];
+    result->max_ns = samples[TDD_BENCH_SAMPLES - 1];
+    private_tdd_bench_histogram(bench, result);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file tdd_bench.h
+ * @brief Micro-benchmarks for the TDD framework
+ * @details A benchmark body is run for a calibrated number of iterations so each
+ *          sample lasts about TDD_BENCH_TARGET_US, the same loop with an empty body
+ *          is subtracted, and TDD_BENCH_SAMPLES samples give min/median/max per op.
+ *
+ * @code
+ * BENCH(bench_xt_bit_count) {
+ *     xt_bitboard_t bb = 0x0123456789ABCDEFULL;    // setup, outside the timed loop cost
+ *     BENCH_LOOP {
+ *         TDD_BENCH_KEEP(xt_bit_count(&bb));
+ *     }
+ * }
+ * RUN_BENCHMARKS(&bench_xt_bit_count)
+ * @endcode
+ * @see tdd_cycles.py - static 8088 cycle estimates of the same BENCH bodies from wdis
+ *      listings, printed in the RUN_BENCHMARKS JSON layout
+ * @ingroup tdd_framework
+ */
+#ifndef TDD_BENCH_H
+#define TDD_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "tdd_report.h"
+
+#ifndef TDD_BENCH_TARGET_US
+#define TDD_BENCH_TARGET_US     20000UL     // calibrated duration of one sample
+#endif
+
+#ifndef TDD_BENCH_SAMPLES
+#define TDD_BENCH_SAMPLES       7
+#endif
+
+#ifndef TDD_BENCH_HISTOGRAM_RUNS
+#define TDD_BENCH_HISTOGRAM_RUNS 256        // single iteration timings per benchmark
+#endif
+
+#define TDD_BENCH_HISTOGRAM_WIDTH 40
+
+#define TDD_BENCH_MAX_ITERATIONS 0x40000000UL
+
+/**
+ * @brief Benchmark case structure
+ */
+typedef struct {
+    void (*fn)(uint32_t);   /**< Body taking the iteration count */
+    char *name;             /**< Benchmark name */
+} bench_t;
+
+/// Results go here so the optimiser cannot drop the measured work
+extern volatile uint32_t tdd_bench_sink;
+
+/**
+ * @brief Keeps a value alive without adding measurable cost
+ */
+#define TDD_BENCH_KEEP(expr) (tdd_bench_sink = (uint32_t)(expr))
+
+/**
+ * @brief Declares a benchmark - the body must contain one BENCH_LOOP
+ * @param name Benchmark name
+ */
+#define BENCH(name)                                     \
+    static void name##_fn(uint32_t);                    \
+    static const bench_t name = {name##_fn, #name};     \
+    static void name##_fn(uint32_t _iterations)
+
+/**
+ * @brief The timed loop of a benchmark
+ */
+#define BENCH_LOOP for (uint32_t _i = 0; _i < _iterations; ++_i)
+
+/**
+ * @brief Calibrates, samples and summarises one benchmark
+ * @details After the calibrated samples the body is also timed one iteration at a
+ *          time, TDD_BENCH_HISTOGRAM_RUNS times, into log2 buckets of timer periods
+ *          so long tails (disk, retrace waits) show up that a median hides.
+ * @param bench Benchmark to run
+ * @param[out] result Per-op timings in nanoseconds and the latency histogram
+ */
+void tdd_bench_run(const bench_t* bench, tdd_bench_result_t* result);
+
+/**
+ * @brief Bucket of a single iteration latency
+ * @param ticks Timer periods, overhead already subtracted
+ * @return Bit length of ticks, capped at TDD_BENCH_BUCKETS - 1
+ */
+uint8_t tdd_bench_bucket(uint64_t ticks);
+
+/**
+ * @brief Plots the non-empty range of a latency histogram with tdd_histogram
+ */
+void tdd_bench_plot(const tdd_bench_result_t* result);
+
+/**
+ * @brief Timer in use - PIT counts on DOS, clock() elsewhere
+ */
+uint64_t tdd_bench_now();
+
+/**
+ * @brief Timer units per second of tdd_bench_now()
+ */
+uint32_t tdd_bench_ticks_per_second();
+
+/**
+ * @brief Starts and stops the high resolution timer around a run
+ */
+void tdd_bench_begin();
+void tdd_bench_end();
+
+/**
+ * @brief Executes a benchmark suite
+ * @param ... Variable list of benchmarks
+ * @return Aborted benchmarks plus those slower than their history.tdd baseline
+ */
+#define RUN_BENCHMARKS(...)                                                 \
+    int run_benchmarks(void) {                                              \
+        static const bench_t* const benches[] = {__VA_ARGS__};              \
+        const tdd_bench_suite_t suite = {_FILENAME, benches, sizeof(benches)/sizeof(benches[0])}; \
+        return tdd_run_bench_suite(&suite, NULL);                           \
+    }
+
+#endif
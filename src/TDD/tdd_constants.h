@@ -13,4 +13,18 @@
 #define CP437_RIGHT_HALF_BLOCK 0xDE
 #define CP437_UPPER_HALF_BLOCK 0xDF
 
+// history.tdd regression detection
+#define TDD_HISTORY_FILE            "history.tdd"
+#define TDD_HISTORY_WINDOW          5       // runs in the median baseline
+#define TDD_HISTORY_MIN_RUNS        3       // fewer runs - no verdict
+#define TDD_HISTORY_MIN_SECONDS     1.0     // clock() ticks at 55ms, shorter suites are noise
+#define TDD_REGRESSION_THRESHOLD    10      // percent slower than baseline
+
+// INT 08h sampling profiler
+#define TDD_PROFILER_VECTOR         0x08    // IRQ 0 timer tick
+#define TDD_PROFILER_RATE_SHIFT     4       // sample 16x faster than the 18.2 Hz BIOS tick
+#define TDD_PROFILER_PROBES         8       // hash collisions tried before a sample is dropped
+#define TDD_PROFILER_MAGIC          "XTPF"
+#define TDD_PROFILER_VERSION        1
+
 #endif
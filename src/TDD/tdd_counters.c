@@ -0,0 +1,40 @@
+#include "tdd_counters.h"
+
+#ifdef TDD_COUNTERS
+
+#include <string.h>
+
+#include "tdd_report.h"
+
+uint32_t tdd_counters[TDD_COUNTER_COUNT];
+
+static const char* counter_groups[TDD_COUNTER_COUNT] = {
+    "search", "search", "tt", "tt", "search", "search", "search", "search", "mda", "bios"
+};
+
+static const char* counter_names[TDD_COUNTER_COUNT] = {
+    "nodes", "qnodes", "probes", "hits", "cutoffs", "first_cutoffs", "make", "unmake", "write_char", "video_calls"
+};
+
+void tdd_counters_reset() {
+    memset(tdd_counters, 0, sizeof(tdd_counters));
+}
+
+static void private_tdd_counters_ratio(FILE* output, const char* group, const char* name, tdd_counter_t part, tdd_counter_t whole) {
+    if (tdd_counters[whole]) {
+        tdd_report_metric(output, group, name, (unsigned long)((uint64_t)tdd_counters[part] * 1000 / tdd_counters[whole]));
+    }
+}
+
+void tdd_counters_report(FILE* output) {
+    for (uint8_t i = 0; i < TDD_COUNTER_COUNT; ++i) {
+        if (tdd_counters[i]) {
+            tdd_report_metric(output, counter_groups[i], counter_names[i], tdd_counters[i]);
+        }
+    }
+    private_tdd_counters_ratio(output, "tt", "hit_permille", TDD_COUNTER_TT_HITS, TDD_COUNTER_TT_PROBES);
+    private_tdd_counters_ratio(output, "search", "first_cutoff_permille", TDD_COUNTER_FIRST_MOVE_CUTOFFS, TDD_COUNTER_CUTOFFS);
+    private_tdd_counters_ratio(output, "search", "qnode_permille", TDD_COUNTER_QNODES, TDD_COUNTER_NODES);
+}
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file tdd_counters.h
+ * @brief Hot path event counters, compiled in with -dTDD_COUNTERS
+ * @details Each counter is a 32 bit slot in a static table so counting costs one
+ *          add/adc pair. Without TDD_COUNTERS every macro expands to nothing.
+ *
+ * @code
+ * TDD_COUNT(TDD_COUNTER_NODES);
+ * if (xt_tt_probe(&tt, hash, &entry)) ...     // counts probes and hits itself
+ * tdd_counters_report(stdout);                // tt.hit_permille, search.first_cutoff_permille
+ * @endcode
+ * @ingroup tdd_framework
+ */
+#ifndef TDD_COUNTERS_H
+#define TDD_COUNTERS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+    TDD_COUNTER_NODES,
+    TDD_COUNTER_QNODES,
+    TDD_COUNTER_TT_PROBES,
+    TDD_COUNTER_TT_HITS,
+    TDD_COUNTER_CUTOFFS,
+    TDD_COUNTER_FIRST_MOVE_CUTOFFS,
+    TDD_COUNTER_MAKE,
+    TDD_COUNTER_UNMAKE,
+    TDD_COUNTER_MDA_WRITE_CHAR,
+    TDD_COUNTER_BIOS_VIDEO,
+    TDD_COUNTER_COUNT
+} tdd_counter_t;
+
+#ifdef TDD_COUNTERS
+
+extern uint32_t tdd_counters[TDD_COUNTER_COUNT];
+
+#define TDD_COUNT(counter)          (++tdd_counters[(counter)])
+#define TDD_COUNT_ADD(counter, n)   (tdd_counters[(counter)] += (n))
+#define TDD_COUNTER(counter)        (tdd_counters[(counter)])
+
+/**
+ * @brief Zeroes every counter
+ */
+void tdd_counters_reset();
+
+/**
+ * @brief Reports non-zero counters and the derived ratios with tdd_report_metric
+ * @note  Ratios are per mille - TT hits per probe, first move cutoffs per cutoff
+ */
+void tdd_counters_report(FILE* output);
+
+#else
+
+#define TDD_COUNT(counter)          ((void)0)
+#define TDD_COUNT_ADD(counter, n)   ((void)0)
+#define TDD_COUNTER(counter)        (0UL)
+#define tdd_counters_reset()        ((void)0)
+#define tdd_counters_report(output) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+"""Estimate 8088 cycles of BENCH bodies from wdis listings, as RUN_BENCHMARKS JSON.
+
+usage: tdd_cycles.py test.lst [more.lst ...] [--mhz 4.77] [--shift-count 1] [--suite cycles]
+
+    wdis -l=test.lst main.obj       (one listing per object holding benches or callees)
+
+A static cost model, not an emulator: one path through the outermost backward
+jump of a BENCH function (the BENCH_LOOP) is costed as one iteration, and calls
+add the cost of one path through their callee when the callee is in a listing.
+The path follows unconditional jumps, falls through forward conditional jumps
+and takes backward ones once, leaving an inner loop after its closing jump.
+Costs come from the Intel 8086 tables with the 8088 8-bit bus on top:
+
+    execution = 8086 clocks + EA clocks + 4 per extra byte of a word transfer
+    bus       = 4 per code byte + 4 per data byte moved
+    cycles    = max(execution, bus)         the 4 byte queue rarely hides the BIU
+
+Forward conditional jumps count as not taken, backward ones as taken; REP string
+operations and shifts by CL count one element and --shift-count bits. The numbers
+are deterministic for a given build, so a change from one commit to the next is
+a change in code, not noise.
+"""
+import argparse
+import json
+import re
+import sys
+import time
+
+LABEL = re.compile(r"^([0-9A-Fa-f]{4,8})\s+([A-Za-z_$@?][\w$@?]*):\s*$")
+INSTRUCTION = re.compile(r"^([0-9A-Fa-f]{4,8})\s+((?:[0-9A-Fa-f]{2} )+)\s*([a-z][a-z0-9]*)\s*(.*)$")
+CONTINUATION = re.compile(r"^\s+((?:[0-9A-Fa-f]{2} ?)+)\s*$")
+BENCH = re.compile(r"^(bench_\w+?)_fn_?$")
+
+REG8 = {"al", "ah", "bl", "bh", "cl", "ch", "dl", "dh"}
+REG16 = {"ax", "bx", "cx", "dx", "si", "di", "bp", "sp"}
+SEG = {"cs", "ds", "es", "ss"}
+
+# reg,reg  reg,mem  mem,reg  reg,imm  mem,imm  - 8086 clocks, EA added for mem forms
+ALU = (3, 9, 16, 4, 17)
+TWO_OPERAND = {
+    "mov": (2, 8, 9, 4, 10),
+    "add": ALU, "adc": ALU, "sub": ALU, "sbb": ALU, "and": ALU, "or": ALU, "xor": ALU,
+    "cmp": (3, 9, 9, 4, 10),
+    "test": (3, 9, 9, 5, 11),
+    "xchg": (4, 17, 17, 4, 17),
+}
+ONE_OPERAND = {         # reg, mem
+    "inc": (2, 15), "dec": (2, 15), "neg": (3, 16), "not": (3, 16),
+    "mul": (126, 134), "imul": (141, 150), "div": (153, 160), "idiv": (175, 182),
+}
+BYTE_ONE_OPERAND = {"inc": 3, "dec": 3, "mul": 74, "imul": 89, "div": 85, "idiv": 107}
+SHIFTS = {"shl", "sal", "shr", "sar", "rol", "ror", "rcl", "rcr"}
+FIXED = {
+    "cbw": 2, "cwd": 5, "clc": 2, "stc": 2, "cmc": 2, "cld": 2, "std": 2, "cli": 2, "sti": 2,
+    "nop": 3, "lahf": 4, "sahf": 4, "pushf": 10, "popf": 8, "xlat": 11, "hlt": 2,
+    "int": 51, "iret": 24, "in": 10, "out": 10, "into": 53, "aaa": 4, "aas": 4, "daa": 4, "das": 4,
+    "aam": 83, "aad": 60, "wait": 3, "lock": 2,
+}
+STRING = {              # clocks per element, memory accesses per element
+    "movsb": (17, 2), "movsw": (17, 2), "stosb": (10, 1), "stosw": (10, 1),
+    "lodsb": (12, 1), "lodsw": (12, 1), "cmpsb": (22, 2), "cmpsw": (22, 2),
+    "scasb": (15, 1), "scasw": (15, 1),
+}
+JCC = {"jo", "jno", "jb", "jc", "jnae", "jae", "jnb", "jnc", "je", "jz", "jne", "jnz", "jbe",
+       "jna", "ja", "jnbe", "js", "jns", "jp", "jpe", "jnp", "jpo", "jl", "jnge", "jge", "jnl",
+       "jle", "jng", "jg", "jnle"}
+
+
+def effective_address(operand):
+    """8086 EA clocks of a memory operand, segment override included."""
+    clocks = 2 if re.search(r"\b(cs|ds|es|ss):", operand) else 0
+    inside = re.search(r"\[([^\]]*)\]", operand)
+    displacement = bool(re.search(r"(0x[0-9a-fA-F]+|\b\d+)\s*\[", operand)) or not inside
+    if not inside:
+        return clocks + 6                           # direct address
+    regs = set(re.findall(r"\b(bx|bp|si|di)\b", inside[1]))
+    if re.search(r"[+-]\s*(0x[0-9a-fA-F]+|\d+)", inside[1]):
+        displacement = True
+    if len(regs) == 2:
+        base = 7 if regs in ({"bp", "di"}, {"bx", "si"}) else 8
+        return clocks + base + (4 if displacement else 0)
+    return clocks + (9 if displacement else 5)
+
+
+def is_memory(operand):
+    if re.match(r"^(near|far) ptr [A-Za-z_$@?][\w$@?]*$", operand):
+        return False                                # direct call or jump target
+    return "[" in operand or " ptr " in f" {operand} " or ":" in operand and not operand.startswith("0x")
+
+
+def is_byte(operands):
+    text = " ".join(operands)
+    if "byte ptr" in text:
+        return True
+    if "word ptr" in text:
+        return False
+    return any(o in REG8 for o in operands)
+
+
+def split_operands(text):
+    text = text.split(";")[0].strip()
+    return [o.strip() for o in text.split(",")] if text else []
+
+
+class Cost:
+    def __init__(self):
+        self.instructions = 0
+        self.execution = 0
+        self.code_bytes = 0
+        self.data_bytes = 0
+        self.memory_accesses = 0
+
+    def add(self, other):
+        self.instructions += other.instructions
+        self.execution += other.execution
+        self.code_bytes += other.code_bytes
+        self.data_bytes += other.data_bytes
+        self.memory_accesses += other.memory_accesses
+
+    @property
+    def bus_cycles(self):
+        return 4 * (self.code_bytes + self.data_bytes)
+
+    @property
+    def cycles(self):
+        return max(self.execution, self.bus_cycles)
+
+
+def instruction_cost(mnemonic, operands, size, address, target, shift_count):
+    """(8086 clocks, memory accesses, data bytes) of one instruction."""
+    memory = [o for o in operands if is_memory(o)]
+    ea = effective_address(memory[0]) if memory else 0
+    width = 1 if is_byte(operands) else 2
+    if mnemonic in STRING or (mnemonic.startswith("rep") and operands and operands[0] in STRING):
+        name = operands[0] if mnemonic.startswith("rep") else mnemonic
+        clocks, accesses = STRING[name]
+        step = 1 if name.endswith("b") else 2
+        return clocks + (9 if name != mnemonic else 0), accesses, accesses * step
+    if mnemonic in TWO_OPERAND and len(operands) == 2:
+        rr, rm, mr, ri, mi = TWO_OPERAND[mnemonic]
+        dst, src = operands
+        immediate = not is_memory(src) and src not in REG8 | REG16 | SEG
+        if is_memory(dst):
+            reads_back = mnemonic not in ("mov",)
+            writes = mnemonic not in ("cmp", "test")
+            accesses = int(reads_back) + int(writes)
+            return (mi if immediate else mr) + ea, accesses, accesses * width
+        if is_memory(src):
+            return rm + ea, 1, width
+        return (ri if immediate else rr), 0, 0
+    if mnemonic in ONE_OPERAND and operands:
+        reg, mem = ONE_OPERAND[mnemonic]
+        if is_memory(operands[0]):
+            accesses = 1 if mnemonic in ("mul", "imul", "div", "idiv") else 2
+            return mem + ea, accesses, accesses * width
+        if width == 1 and mnemonic in BYTE_ONE_OPERAND:
+            return BYTE_ONE_OPERAND[mnemonic], 0, 0
+        return reg, 0, 0
+    if mnemonic in SHIFTS and operands:
+        by_cl = len(operands) > 1 and operands[1] == "cl"
+        if is_memory(operands[0]):
+            return (20 + 4 * shift_count if by_cl else 15) + ea, 2, 2 * width
+        return (8 + 4 * shift_count if by_cl else 2), 0, 0
+    if mnemonic == "push":
+        if operands and is_memory(operands[0]):
+            return 16 + ea, 2, 4
+        return (10 if operands and operands[0] in SEG else 11), 1, 2
+    if mnemonic == "pop":
+        if operands and is_memory(operands[0]):
+            return 17 + ea, 2, 4
+        return 8, 1, 2
+    if mnemonic == "lea":
+        return 2 + ea, 0, 0
+    if mnemonic in ("lds", "les"):
+        return 16 + ea, 2, 4
+    if mnemonic == "call":
+        far = bool(operands) and ("far" in operands[0] or ":" in operands[0] and not is_memory(operands[0]))
+        if operands and is_memory(operands[0]):
+            return (37 if far else 21) + ea, (3 if far else 2), (8 if far else 4)
+        return (28 if far else 19), (2 if far else 1), (4 if far else 2)
+    if mnemonic in ("ret", "retn", "retf"):
+        far = mnemonic == "retf"
+        pops = bool(operands)
+        return (17 if far else 12) if pops else (18 if far else 8), (2 if far else 1), (4 if far else 2)
+    if mnemonic == "jmp":
+        if operands and is_memory(operands[0]):
+            return 18 + ea, 1, 2
+        return 15, 0, 0
+    if mnemonic in JCC or mnemonic in ("loop", "loope", "loopz", "loopne", "loopnz", "jcxz"):
+        taken = target is not None and target <= address
+        table = {"loop": (17, 5), "jcxz": (18, 6)}.get(mnemonic, (19, 5) if mnemonic.startswith("loop") else (16, 4))
+        return table[0] if taken else table[1], 0, 0
+    if mnemonic in FIXED:
+        return FIXED[mnemonic], 0, 0
+    if mnemonic == "movs" or mnemonic == "stos":
+        return 17, 2, 4
+    return None
+
+
+def parse_listing(path, functions, labels):
+    """Adds {function: [[address, mnemonic, operands, size]]} and {function: {L$n: address}}."""
+    current = None
+    last = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            m = LABEL.match(line)
+            if m and m[2].startswith("L$"):
+                if current:
+                    labels.setdefault(current, {})[m[2]] = int(m[1], 16)
+                continue
+            if m:
+                current = m[2]
+                functions.setdefault(current, [])
+                last = None
+                continue
+            m = INSTRUCTION.match(line)
+            if m and current:
+                size = len(m[2].split())
+                last = [int(m[1], 16), m[3], split_operands(m[4]), size]
+                functions[current].append(last)
+                continue
+            m = CONTINUATION.match(line)
+            if m and last:
+                last[3] += len(m[1].split())        # long encodings wrap onto the next line
+            elif line.startswith("Segment:"):
+                current = None
+
+
+def jump_target(operands):
+    if not operands:
+        return None
+    m = re.match(r"^(?:short |near )?(?:L\$\d+|0x([0-9a-fA-F]+)|([0-9a-fA-F]{4,8}))$", operands[0])
+    if m and (m[1] or m[2]):
+        return int(m[1] or m[2], 16)
+    return None
+
+
+def callee_name(operands):
+    if not operands:
+        return None
+    name = operands[0].replace("near ptr ", "").replace("far ptr ", "").strip()
+    return name if re.match(r"^[A-Za-z_$@?][\w$@?]*$", name) else None
+
+
+def local_target(operands, local):
+    target = jump_target(operands)
+    if target is None and operands:
+        target = local.get(operands[0].replace("short ", "").replace("near ", ""))
+    return target
+
+
+def walk(instructions, local, start=0, stop=None):
+    """Indices on the modelled path from start, to a return or through index stop."""
+    position = {}
+    for i, ins in enumerate(instructions):
+        position.setdefault(ins[0], i)
+    visited = set()
+    i = start
+    while 0 <= i < len(instructions) and i not in visited:
+        visited.add(i)
+        yield i
+        address, mnemonic, operands, _ = instructions[i]
+        if i == stop or mnemonic in ("ret", "retn", "retf", "iret"):
+            return
+        conditional = mnemonic in JCC or mnemonic.startswith("loop") or mnemonic == "jcxz"
+        if mnemonic != "jmp" and not conditional:
+            i += 1
+            continue
+        target = local_target(operands, local)
+        if target is None:
+            if mnemonic == "jmp":
+                return                              # indirect or far - nowhere to follow
+            i += 1
+            continue
+        j = position.get(target, next((k for k, ins in enumerate(instructions) if ins[0] >= target), len(instructions)))
+        if target > address:
+            i = j if mnemonic == "jmp" else i + 1   # forward conditional jumps not taken
+        else:
+            i = j if j not in visited else i + 1    # once round a loop, then out
+
+
+def path_cost(name, functions, labels, shift_count, unknown, start=0, stop=None, stack=()):
+    """Cost of one path through a function, known callees included."""
+    cost = Cost()
+    instructions = functions[name]
+    for i in walk(instructions, labels.get(name, {}), start, stop):
+        address, mnemonic, operands, size = instructions[i]
+        cost.add(one_instruction(name, address, mnemonic, operands, size, labels, shift_count, unknown))
+        if mnemonic == "call" and callee_name(operands):
+            cost.add(function_cost(callee_name(operands), functions, labels, shift_count, unknown, stack + (name,)))
+    return cost
+
+
+def function_cost(name, functions, labels, shift_count, unknown, stack=()):
+    """Cost of one path through a whole function with its known callees."""
+    if name not in functions or name in stack:
+        unknown.add(name)
+        return Cost()
+    return path_cost(name, functions, labels, shift_count, unknown, stack=stack)
+
+
+def one_instruction(function, address, mnemonic, operands, size, labels, shift_count, unknown):
+    cost = Cost()
+    target = jump_target(operands)
+    if target is None and operands and operands[0] in labels.get(function, {}):
+        target = labels[function][operands[0]]
+    estimate = instruction_cost(mnemonic, operands, size, address, target, shift_count)
+    if estimate is None:
+        unknown.add(mnemonic)
+        estimate = (4 * size, 0, 0)
+    clocks, accesses, data = estimate
+    words = data // 2
+    cost.instructions = 1
+    cost.execution = clocks + 4 * words     # second byte of each word on the 8-bit bus
+    cost.code_bytes = size
+    cost.data_bytes = data
+    cost.memory_accesses = accesses
+    return cost
+
+
+def loop_body(instructions, labels):
+    """Indices of the outermost backward jump's range - the BENCH_LOOP."""
+    best = None
+    for i, (address, mnemonic, operands, _) in enumerate(instructions):
+        if mnemonic in JCC or mnemonic == "jmp" or mnemonic.startswith("loop"):
+            target = local_target(operands, labels)
+            if target is not None and target <= address:
+                start = next((j for j, ins in enumerate(instructions) if ins[0] >= target), 0)
+                if best is None or i - start > best[1] - best[0]:
+                    best = (start, i)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("listings", nargs="+")
+    parser.add_argument("--mhz", type=float, default=4.77)
+    parser.add_argument("--shift-count", type=int, default=1)
+    parser.add_argument("--suite", default="cycles")
+    args = parser.parse_args()
+
+    functions = {}
+    labels = {}                                 # local L$n labels by function
+    for path in args.listings:
+        parse_listing(path, functions, labels)
+
+    benches = []
+    unknown = set()
+    for name in sorted(functions):
+        m = BENCH.match(name)
+        if not m:
+            continue
+        body = loop_body(functions[name], labels.get(name, {}))
+        start, stop = body if body else (0, None)
+        per_iteration = path_cost(name, functions, labels, args.shift_count, unknown, start, stop)
+        ns = per_iteration.cycles * 1000.0 / args.mhz
+        benches.append({
+            "name": m[1], "iterations": 1, "samples": 1,
+            "min_ns": round(ns, 1), "median_ns": round(ns, 1), "max_ns": round(ns, 1),
+            "baseline_ns": 0.0, "regressed": False, "bucket_ns": 0.0, "buckets": [0] * 16,
+            "instructions": per_iteration.instructions, "cycles": per_iteration.cycles,
+            "bus_cycles": per_iteration.bus_cycles, "memory_accesses": per_iteration.memory_accesses,
+        })
+    if not benches:
+        sys.exit("no bench_*_fn functions in the listings")
+    unknown.discard(None)
+    if unknown:
+        print("not costed: " + ", ".join(sorted(unknown)), file=sys.stderr)
+
+    summary = {
+        "suite": args.suite, "passed": len(benches), "failed": 0, "total": len(benches),
+        "regressed": 0, "time": 0.0, "baseline": 0.0, "timestamp": int(time.time()),
+        "benchmarks": benches,
+    }
+    print(json.dumps(summary, separators=(",", ":")))
+
+
+if __name__ == "__main__":
+    main()
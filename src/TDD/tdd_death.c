@@ -0,0 +1,30 @@
+#include "tdd_death.h"
+
+#include <signal.h>
+#include <stddef.h>
+
+static jmp_buf* armed = NULL;
+
+static void private_tdd_death_handler(int sig) {
+    if (!armed) {
+        signal(sig, SIG_DFL);
+        raise(sig);
+        return;
+    }
+    signal(SIGABRT, private_tdd_death_handler);     // handlers reset to SIG_DFL on delivery
+    longjmp(*armed, 1);
+}
+
+jmp_buf* tdd_death_arm(jmp_buf* jump) {
+    jmp_buf* previous = armed;
+    armed = jump;
+    signal(SIGABRT, private_tdd_death_handler);
+    return previous;
+}
+
+void tdd_death_disarm(jmp_buf* previous) {
+    armed = previous;
+    if (!armed) {
+        signal(SIGABRT, SIG_DFL);
+    }
+}
@@ -0,0 +1,26 @@
+/**
+ * @file tdd_death.h
+ * @brief SIGABRT to longjmp bridge for death tests and crash isolation
+ * @details assert() and abort() raise SIGABRT; while a jump is armed the handler
+ *          longjmps back to it instead of ending the program. Jumps nest so a
+ *          death test inside an isolated test returns to the innermost one.
+ * @ingroup tdd_framework
+ */
+#ifndef TDD_DEATH_H
+#define TDD_DEATH_H
+
+#include <setjmp.h>
+
+/**
+ * @brief Arms a jump for SIGABRT
+ * @param jump Buffer already filled by setjmp in the caller's frame
+ * @return The jump armed before, for tdd_death_disarm()
+ */
+jmp_buf* tdd_death_arm(jmp_buf* jump);
+
+/**
+ * @brief Re-arms the previous jump, or the default SIGABRT action if there was none
+ */
+void tdd_death_disarm(jmp_buf* previous);
+
+#endif
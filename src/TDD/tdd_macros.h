@@ -21,6 +21,9 @@
 
 #include "tdd_report.h"
 #include "tdd_progress.h"
+#include "tdd_bench.h"
+#include "tdd_counters.h"
+#include "tdd_runner.h"
 
 // ========================
 // DEATH TEST INFRASTRUCTURE
@@ -28,6 +31,8 @@
 #include <setjmp.h>
 #include <signal.h>
 
+#include "tdd_death.h"
+
 /**
  * @brief Conditional verbose output macro
  * @param expr Expression to execute only in debug mode
@@ -124,6 +129,37 @@
  */
 #define ASSERT(expr, ...) _ASSERT(expr, true)
 
+/**
+ * @brief Expects a statement to abort, e.g. by failing an assert()
+ * @details setjmp has to run in the test's own frame so the macro arms the jump
+ *          itself; the SIGABRT handler in tdd_death.c longjmps back here.
+ * @note Skipped with NDEBUG - there is no assert() left to fail
+ * @code
+ * EXPECT_DEATH(xt_bit_count(NULL));
+ * @endcode
+ */
+#ifndef NDEBUG
+#define EXPECT_DEATH(statement, ...) do { \
+    jmp_buf _death_jump; \
+    jmp_buf* volatile _death_previous = NULL; \
+    if (setjmp(_death_jump) == 0) { \
+        _death_previous = tdd_death_arm(&_death_jump); \
+        statement; \
+        tdd_death_disarm(_death_previous); \
+        printf("\n%s:%d - FAILED: %s did not abort\n", _FILENAME, __LINE__, #statement); \
+        if (strlen("" #__VA_ARGS__) > 0) printf("  Message:  " __VA_ARGS__ "\n"); \
+        *pass = false; \
+    } \
+    else { \
+        tdd_death_disarm(_death_previous); \
+    } \
+} while (0)
+#else
+#define EXPECT_DEATH(statement, ...) do { \
+    V(printf("%s:%d - SKIPPED: EXPECT_DEATH(%s) with NDEBUG\n", _FILENAME, __LINE__, #statement);); \
+} while (0)
+#endif
+
 // =============================================
 // Numeric Comparisons
 // =============================================
@@ -236,14 +272,6 @@
     } \
 } while (0)
 
-/**
- * @brief Test case structure
- */
-typedef struct {
-    void (*fn)(bool*);   /**< Test function pointer */
-    char *name;          /**< Test name */
-} test_t;
-
 /**
  * @brief Declares a test case
  * @param name Test case name
@@ -261,32 +289,20 @@ typedef struct {
 /**
  * @brief Executes a test suite
  * @param ... Variable list of test cases
- * @return Number of failed tests
+ * @return Number of failed tests plus time regressions
  *
  * @details Handles:
  *          - Test execution
  *          - Result reporting
  *          - Failure counting
+ *          - Regression check against history.tdd
  *          - Verbosity control
  */
  #define RUN_TESTS(...)                                                  \
      int run_tests(void) {                                               \
-         const test_t* tests[] = {__VA_ARGS__};                          \
-         test_summary_t summary = {0};                                   \
-         summary.suite_name = _FILENAME;                                 \
-         clock_t start = clock();                                        \
-                                                                         \
-         for (size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); i++) {   \
-             bool passed = true;                                         \
-             tests[i]->fn(&passed);                                      \
-             summary.total++;                                            \
-             passed ? summary.passed++ : summary.failed++;               \
-         }                                                               \
-                                                                         \
-         summary.time_elapsed = (double)(clock() - start) / CLOCKS_PER_SEC; \
-         tdd_generate_report(summary, stdout);                           \
-         tdd_save_history(summary);                                      \
-         return summary.failed;                                          \
+         static const test_t* const tests[] = {__VA_ARGS__};             \
+         const tdd_suite_t suite = {_FILENAME, tests, sizeof(tests)/sizeof(tests[0])}; \
+         return tdd_run_suite(&suite, NULL);                             \
      }
 
 #endif
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Map tdd_profiler samples to functions using the Watcom map file.
+
+usage: tdd_profile.py PROFILE.BIN chess.map [--top N]
+
+The map lists symbols as SSSS:OOOO relative to the start of the load image,
+which DOS placed at PSP + 10h - the PSP segment is in the profile header.
+Samples outside the image (BIOS, DOS, TSRs) are grouped as <outside>.
+"""
+import argparse
+import bisect
+import re
+import struct
+import sys
+from collections import Counter
+
+HEADER = struct.Struct("<4sHHHHII")
+SLOT = struct.Struct("<HHH")
+SYMBOL = re.compile(r"^([0-9a-fA-F]{4}):([0-9a-fA-F]{4})[+*]?\s+(\S+)")
+
+
+def read_profile(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, psp, rate, used, samples, dropped = HEADER.unpack_from(data)
+    if magic != b"XTPF" or version != 1:
+        sys.exit(f"{path}: not a version 1 tdd_profiler file")
+    slots = [SLOT.unpack_from(data, HEADER.size + i * SLOT.size) for i in range(used)]
+    return psp, rate, samples, dropped, slots
+
+
+def read_map(path):
+    """Symbols of the 'Memory Map' section as (image offset, name), sorted."""
+    symbols = []
+    in_memory_map = False
+    with open(path, errors="replace") as f:
+        for line in f:
+            if "Memory Map" in line:
+                in_memory_map = True
+            elif in_memory_map:
+                m = SYMBOL.match(line)
+                if m:
+                    seg, off, name = int(m[1], 16), int(m[2], 16), m[3]
+                    symbols.append((seg * 16 + off, name))
+    symbols.sort()
+    return symbols
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("profile")
+    parser.add_argument("map")
+    parser.add_argument("--top", type=int, default=30)
+    args = parser.parse_args()
+
+    psp, rate, samples, dropped, slots = read_profile(args.profile)
+    symbols = read_map(args.map)
+    if not symbols:
+        sys.exit(f"{args.map}: no symbols - link with 'option map'")
+    starts = [s[0] for s in symbols]
+    image = (psp + 0x10) * 16
+    end = starts[-1] + 0x10000                  # last symbol's segment at most
+
+    hits = Counter()
+    for cs, ip, count in slots:
+        offset = cs * 16 + ip - image
+        i = bisect.bisect_right(starts, offset) - 1
+        hits[symbols[i][1] if 0 <= offset < end and i >= 0 else "<outside>"] += count
+
+    total = sum(hits.values()) or 1
+    print(f"{samples} samples at {rate} Hz ({samples / rate:.2f}s), {dropped} dropped")
+    print(f"{'samples':>8} {'%':>6}  function")
+    for name, count in hits.most_common(args.top):
+        print(f"{count:8} {100.0 * count / total:6.2f}  {name}")
+
+
+if __name__ == "__main__":
+    main()
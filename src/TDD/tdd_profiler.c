@@ -0,0 +1,138 @@
+#include "tdd_profiler.h"
+
+#include <assert.h>
+#include <dos.h>
+#include <i86.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tdd_constants.h"
+#include "../BIOS/bios_pit_timer.h"
+#include "../BIOS/bios_timer_io_constants.h"
+#include "../DOS/dos_services.h"
+
+#define TDD_PROFILER_DIVISOR (uint16_t)(0x10000UL >> TDD_PROFILER_RATE_SHIFT)
+
+static void (__interrupt __far *private_tdd_bios_tick)() = NULL;
+static tdd_profiler_slot_t* table = NULL;
+static uint16_t table_mask = 0;
+static volatile uint32_t samples = 0;
+static volatile uint32_t dropped = 0;
+static volatile uint8_t ticks_to_chain = 0;
+
+#pragma off (check_stack)
+
+/**
+* @brief Runs at 2^TDD_PROFILER_RATE_SHIFT x 18.2 Hz with interrupts off
+* @note Only 16 bit arithmetic and no calls - an 8088 has ~260 cycles between the faster ticks
+*/
+static void __interrupt __far private_tdd_profiler_tick(union INTPACK r) {
+    uint16_t slot = (r.w.ip ^ (r.w.cs << 3)) & table_mask;
+    uint8_t probe = 0;
+    while (probe < TDD_PROFILER_PROBES) {
+        tdd_profiler_slot_t* s = &table[slot];
+        if (s->count && s->cs == r.w.cs && s->ip == r.w.ip) {
+            if (s->count != 0xFFFF) s->count++;
+            break;
+        }
+        if (!s->count) {
+            s->cs = r.w.cs;
+            s->ip = r.w.ip;
+            s->count = 1;
+            break;
+        }
+        slot = (slot + 1) & table_mask;
+        ++probe;
+    }
+    if (probe == TDD_PROFILER_PROBES) {
+        dropped++;
+    } else {
+        samples++;
+    }
+    if (++ticks_to_chain == (1 << TDD_PROFILER_RATE_SHIFT)) {
+        ticks_to_chain = 0;
+        _chain_intr(private_tdd_bios_tick);    // BIOS updates 40:6C and sends the EOI
+    }
+    __asm {
+        .8086
+        mov     al, BIOS_PIC_EOI
+        out     BIOS_PIC_COMMAND_PORT, al
+    }
+}
+
+#pragma on (check_stack)
+
+bool tdd_profiler_start(mem_arena_t* arena, uint16_t slots) {
+    assert(arena && "NULL arena!");
+    assert(mem_arena_policy(arena) != MEM_ARENA_POLICY_EMS && "EMS memory has no real-mode address!");
+    assert(slots && !(slots & (slots - 1)) && "slots must be a power of 2!");
+    if (private_tdd_bios_tick || mem_arena_policy(arena) == MEM_ARENA_POLICY_EMS) {
+        return false;
+    }
+    table = (tdd_profiler_slot_t*)mem_arena_calloc(arena, (mem_size_t)slots * sizeof(tdd_profiler_slot_t));
+    if (!table) {
+        return false;
+    }
+    table_mask = slots - 1;
+    samples = dropped = 0;
+    ticks_to_chain = 0;
+    private_tdd_bios_tick = (void (__interrupt __far *)())dos_get_interrupt_vector(TDD_PROFILER_VECTOR);
+    dos_set_interrupt_vector(TDD_PROFILER_VECTOR, (void*)private_tdd_profiler_tick);
+    bios_pit_timer_rate(TDD_PROFILER_DIVISOR);
+    return true;
+}
+
+void tdd_profiler_stop() {
+    if (!private_tdd_bios_tick) {
+        return;
+    }
+    bios_pit_timer_restore();
+    dos_set_interrupt_vector(TDD_PROFILER_VECTOR, (void*)private_tdd_bios_tick);
+    private_tdd_bios_tick = NULL;
+}
+
+uint32_t tdd_profiler_samples() {
+    return samples;
+}
+
+uint32_t tdd_profiler_dropped() {
+    return dropped;
+}
+
+bool tdd_profiler_save(const char* path) {
+    assert(path && "NULL path!");
+    assert(!private_tdd_bios_tick && "Profiler still running!");
+    if (!table || !samples) {
+        return false;
+    }
+    tdd_profiler_header_t header;
+    memcpy(header.magic, TDD_PROFILER_MAGIC, sizeof(header.magic));
+    header.version = TDD_PROFILER_VERSION;
+    header.psp = _psp;
+    header.rate = (uint16_t)(BIOS_PIT_FREQUENCY / TDD_PROFILER_DIVISOR);
+    header.used = 0;
+    header.samples = samples;
+    header.dropped = dropped;
+    for (uint32_t i = 0; i <= table_mask; ++i) {
+        header.used += (table[i].count != 0);
+    }
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    for (uint32_t i = 0; ok && i <= table_mask; ++i) {
+        if (table[i].count) {
+            ok = fwrite(&table[i], sizeof(tdd_profiler_slot_t), 1, out) == 1;
+        }
+    }
+    return (fclose(out) == 0) && ok;
+}
+
+void tdd_profiler_release() {
+    assert(!private_tdd_bios_tick && "Profiler still running!");
+    table = NULL;
+    table_mask = 0;
+    samples = dropped = 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file tdd_profiler.h
+ * @brief Sampling profiler driven by the INT 08h timer interrupt
+ * @details Channel 0 of the PIT is sped up by 2^TDD_PROFILER_RATE_SHIFT and every tick
+ *          records the interrupted CS:IP in an arena-backed hash table; every
+ *          2^TDD_PROFILER_RATE_SHIFT ticks the original handler is chained so the BIOS
+ *          time of day keeps running. Saved samples are mapped to functions on the host
+ *          with tdd_profile.py and the Watcom map file (wlink option map).
+ *
+ * @code
+ * mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_DOS, 16384);
+ * tdd_profiler_start(arena, 2048);
+ * search(&position, depth);
+ * tdd_profiler_stop();
+ * tdd_profiler_save("PROFILE.BIN");
+ * tdd_profiler_release();
+ * mem_arena_delete(arena);
+ * @endcode
+ *
+ * File layout, little endian: tdd_profiler_header_t then header.used tdd_profiler_slot_t
+ * @note Exclusive with bios_pit_timer - both own channel 0
+ * @ingroup tdd_framework
+ */
+#ifndef TDD_PROFILER_H
+#define TDD_PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../MEM/mem_arena.h"
+
+typedef struct {
+    uint16_t cs;        ///< Interrupted code segment
+    uint16_t ip;        ///< Interrupted instruction pointer
+    uint16_t count;     ///< Ticks seen here, saturates at 0xFFFF
+} tdd_profiler_slot_t;
+
+typedef struct {
+    char magic[4];      ///< TDD_PROFILER_MAGIC
+    uint16_t version;   ///< TDD_PROFILER_VERSION
+    uint16_t psp;       ///< Program segment prefix - the load image starts at psp + 10h
+    uint16_t rate;      ///< Samples per second
+    uint16_t used;      ///< Slots that follow
+    uint32_t samples;   ///< Ticks recorded
+    uint32_t dropped;   ///< Ticks lost to a full table
+} tdd_profiler_header_t;
+
+/**
+ * @brief Hooks INT 08h and starts sampling
+ * @param arena Arena the table is allocated from
+ * @param slots Distinct CS:IP values to hold, a power of 2
+ * @return false if already running or the arena is too small
+ */
+bool tdd_profiler_start(mem_arena_t* arena, uint16_t slots);
+
+/**
+ * @brief Restores INT 08h and the PIT rate, keeps the samples
+ */
+void tdd_profiler_stop();
+
+/**
+ * @brief Ticks recorded since tdd_profiler_start()
+ */
+uint32_t tdd_profiler_samples();
+
+/**
+ * @brief Ticks lost because the table was full
+ */
+uint32_t tdd_profiler_dropped();
+
+/**
+ * @brief Writes the header and non-empty slots
+ * @param path DOS file name
+ * @return false if there are no samples or the file could not be written
+ */
+bool tdd_profiler_save(const char* path);
+
+/**
+ * @brief Forgets the table so its arena can be deleted or rewound
+ * @note Call after tdd_profiler_stop() and any tdd_profiler_save()
+ */
+void tdd_profiler_release();
+
+#endif
@@ -1,7 +1,15 @@
 #include "tdd_report.h"
+#include "tdd_constants.h"
+#include "tdd_bench.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
+#define TDD_HISTORY_KEY_SIZE 64
+
 static report_format_t current_format = REPORT_CONSOLE;
+static uint8_t regression_threshold = TDD_REGRESSION_THRESHOLD;
 
 void tdd_set_format(report_format_t format) {
     current_format = format;
@@ -16,17 +24,56 @@ void tdd_generate_report(test_summary_t s, FILE* output) {
             fprintf(output, "\n__| %s |________________________________\n", s.suite_name);
             fprintf(output, "  Tests:  %d\n  Passed: %d\n  Failed: %d\n  Time:   %.3fs\n",
                    s.total, s.passed, s.failed, s.time_elapsed);
+            if (s.baseline_time > 0.0) {
+                fprintf(output, "  Base:   %.3fs\n", s.baseline_time);
+            }
+            if (s.regressed) {
+                fprintf(output, "  Slower: %d\n", s.regressed);
+            }
             fprintf(output, "  Status: %s\n",
-                   (s.failed == 0) ? ":) ALL PASSED" : ":( FAILURES");
+                   (s.failed) ? ":( FAILURES" : (s.regressed) ? ":( REGRESSIONS" : ":) ALL PASSED");
+            if (s.bench_count) {
+                fprintf(output, "  %-24s %10s %10s %10s ns/op\n", "Benchmark", "min", "median", "max");
+            }
+            for (int i = 0; i < s.bench_count; ++i) {
+                fprintf(output, "  %-24s %10.1f %10.1f %10.1f",
+                       s.benches[i].name, s.benches[i].min_ns, s.benches[i].median_ns, s.benches[i].max_ns);
+                if (s.benches[i].regressed) {
+                    fprintf(output, " << %.1f", s.benches[i].baseline_ns);
+                }
+                fprintf(output, "\n");
+            }
+            for (int i = 0; i < s.bench_count; ++i) {
+                tdd_bench_plot(&s.benches[i]);
+            }
             fprintf(output, "----------------------------------------------\n");
             break;
         }
         case REPORT_JSON: {
             fprintf(output,
                 "{\"suite\":\"%s\",\"passed\":%d,\"failed\":%d,"
-                "\"total\":%d,\"time\":%.3f,\"timestamp\":%ld}\n",
-                s.suite_name, s.passed, s.failed, s.total,
-                s.time_elapsed, now);
+                "\"total\":%d,\"regressed\":%d,\"time\":%.3f,\"baseline\":%.3f,\"timestamp\":%ld",
+                s.suite_name, s.passed, s.failed, s.total, s.regressed,
+                s.time_elapsed, s.baseline_time, now);
+            if (s.bench_count) {
+                fprintf(output, ",\"benchmarks\":[");
+                for (int i = 0; i < s.bench_count; ++i) {
+                    fprintf(output,
+                        "%s{\"name\":\"%s\",\"iterations\":%lu,\"samples\":%d,"
+                        "\"min_ns\":%.1f,\"median_ns\":%.1f,\"max_ns\":%.1f,"
+                        "\"baseline_ns\":%.1f,\"regressed\":%s,\"bucket_ns\":%.1f,\"buckets\":[",
+                        (i) ? "," : "", s.benches[i].name, s.benches[i].iterations, s.benches[i].samples,
+                        s.benches[i].min_ns, s.benches[i].median_ns, s.benches[i].max_ns,
+                        s.benches[i].baseline_ns, (s.benches[i].regressed) ? "true" : "false",
+                        s.benches[i].bucket_ns);
+                    for (int b = 0; b < TDD_BENCH_BUCKETS; ++b) {
+                        fprintf(output, "%s%lu", (b) ? "," : "", (unsigned long)s.benches[i].histogram[b]);
+                    }
+                    fprintf(output, "]}");
+                }
+                fprintf(output, "]");
+            }
+            fprintf(output, "}\n");
             break;
         }
         case REPORT_VERBOSE: {
@@ -46,17 +93,109 @@ void tdd_generate_report(test_summary_t s, FILE* output) {
             if (s.failed > 0) {
                 fprintf(output, "FAILURES: %d/%d\n", s.failed, s.total);
             }
+            if (s.regressed > 0) {
+                fprintf(output, "REGRESSIONS: %d\n", s.regressed);
+            }
+            break;
+    }
+}
+
+void tdd_report_metric(FILE* output, const char* group, const char* name, unsigned long value) {
+    switch (current_format) {
+        case REPORT_CONSOLE:
+        case REPORT_VERBOSE:
+            fprintf(output, "  %s.%s: %lu\n", group, name, value);
+            break;
+        case REPORT_JSON:
+            fprintf(output, "{\"metric\":\"%s.%s\",\"value\":%lu}\n", group, name, value);
+            break;
+        case REPORT_SILENT:
             break;
     }
 }
 
 void tdd_save_history(test_summary_t s) {
-    FILE* hist = fopen("history.tdd", "a");
+    FILE* hist = fopen(TDD_HISTORY_FILE, "a");
     if (hist) {
         time_t now;
         time(&now);
         fprintf(hist, "%ld|%s|%d|%d|%.3f\n",
                 now, s.suite_name, s.passed, s.failed, s.time_elapsed);
+        for (int i = 0; i < s.bench_count; ++i) {   // same layout, ns per op in the time column
+            fprintf(hist, "%ld|%s:%s|%d|0|%.1f\n",
+                    now, s.suite_name, s.benches[i].name, s.benches[i].samples, s.benches[i].median_ns);
+        }
         fclose(hist);
     }
 }
+
+void tdd_set_regression_threshold(uint8_t percent) {
+    regression_threshold = percent;
+}
+
+static int private_tdd_compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+uint8_t tdd_history_baseline(const char* key, double* baseline) {
+    assert(key && "NULL key!");
+    assert(baseline && "NULL baseline!");
+    double window[TDD_HISTORY_WINDOW];
+    uint16_t runs = 0;
+    *baseline = 0.0;
+    FILE* hist = fopen(TDD_HISTORY_FILE, "r");
+    if (!hist) {
+        return 0;
+    }
+    char line[128];
+    char name[TDD_HISTORY_KEY_SIZE];
+    long when;
+    int passed, failed;
+    double value;
+    while (fgets(line, sizeof(line), hist)) {
+        if (sscanf(line, "%ld|%63[^|]|%d|%d|%lf", &when, name, &passed, &failed, &value) == 5
+            && failed == 0 && strcmp(name, key) == 0) {
+            window[runs % TDD_HISTORY_WINDOW] = value;    // ring of the most recent runs
+            runs++;
+        }
+    }
+    fclose(hist);
+    uint8_t n = (runs < TDD_HISTORY_WINDOW) ? (uint8_t)runs : TDD_HISTORY_WINDOW;
+    if (n) {
+        qsort(window, n, sizeof(double), private_tdd_compare_doubles);
+        *baseline = (n & 1) ? window[n / 2] : (window[n / 2 - 1] + window[n / 2]) / 2.0;
+    }
+    return n;
+}
+
+static bool private_tdd_slower(double value, double baseline) {
+    return value > baseline * (100.0 + regression_threshold) / 100.0;
+}
+
+int tdd_check_regressions(test_summary_t* s) {
+    assert(s && "NULL summary!");
+    char key[TDD_HISTORY_KEY_SIZE];
+    double baseline;
+    s->regressed = 0;
+    s->baseline_time = 0.0;
+    if (tdd_history_baseline(s->suite_name, &baseline) >= TDD_HISTORY_MIN_RUNS) {
+        s->baseline_time = baseline;
+        if (baseline >= TDD_HISTORY_MIN_SECONDS && private_tdd_slower(s->time_elapsed, baseline)) {
+            s->regressed++;
+        }
+    }
+    for (int i = 0; i < s->bench_count; ++i) {
+        tdd_bench_result_t* b = &s->benches[i];
+        b->baseline_ns = 0.0;
+        b->regressed = false;
+        snprintf(key, sizeof(key), "%s:%s", s->suite_name, b->name);
+        if (tdd_history_baseline(key, &baseline) >= TDD_HISTORY_MIN_RUNS) {
+            b->baseline_ns = baseline;
+            b->regressed = private_tdd_slower(b->median_ns, baseline);
+            s->regressed += b->regressed;
+        }
+    }
+    return s->regressed;
+}
@@ -7,6 +7,12 @@
 #define TDD_REPORT_H
 
 #include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tdd_types.h"
+
+#define TDD_BENCH_BUCKETS 16    // log2 latency buckets, the last one open ended
 
 typedef enum {
     REPORT_CONSOLE,    // Human-readable (default)
@@ -15,12 +21,29 @@ typedef enum {
     REPORT_SILENT      // Only failures (benchmarking mode)
 } report_format_t;
 
+typedef struct {
+    const char* name;
+    unsigned long iterations;   // per sample after calibration
+    int samples;
+    double min_ns;              // per op, empty loop subtracted
+    double median_ns;
+    double max_ns;
+    double baseline_ns;         // median of recent history, 0 when unknown
+    bool regressed;
+    double bucket_ns;           // timer period, bucket b holds [2^(b-1), 2^b) periods
+    tdd_size_t histogram[TDD_BENCH_BUCKETS]; // single iteration latencies
+} tdd_bench_result_t;
+
 typedef struct {
     int total;
     int passed;
     int failed;
     const char* suite_name;
     double time_elapsed;  // Seconds
+    tdd_bench_result_t* benches;  // NULL for test suites
+    int bench_count;
+    int regressed;        // suite time and benchmarks slower than baseline
+    double baseline_time; // Seconds, 0 when unknown
 } test_summary_t;
 
 // ========================
@@ -39,10 +62,43 @@ void tdd_set_format(report_format_t format);
  */
 void tdd_generate_report(test_summary_t summary, FILE* output);
 
+/**
+ * @brief Reports a single named measurement alongside the test results
+ * @param output FILE* to write to (stdout/stderr/file)
+ * @param group  Owner of the metric e.g. an arena or suite name
+ * @param name   Metric name e.g. "peak"
+ * @param value  Measured value
+ * @note  One line per metric, JSON lines in REPORT_JSON, nothing in REPORT_SILENT
+ */
+void tdd_report_metric(FILE* output, const char* group, const char* name, unsigned long value);
+
 /**
  * @brief Saves historical data to a .tdd_history file
  * @note  Appends results for trend analysis (pass/fail over time)
  */
 void tdd_save_history(test_summary_t summary);
 
+/**
+ * @brief Sets how much slower than the baseline counts as a regression
+ * @param percent Slowdown in percent (default: TDD_REGRESSION_THRESHOLD)
+ */
+void tdd_set_regression_threshold(uint8_t percent);
+
+/**
+ * @brief Median of the last TDD_HISTORY_WINDOW passing runs of a key
+ * @param key      Suite name, or "suite:benchmark" for benchmark medians
+ * @param[out] baseline Seconds for suites, ns per op for benchmarks
+ * @return Number of runs the baseline was taken from, 0 if none
+ */
+uint8_t tdd_history_baseline(const char* key, double* baseline);
+
+/**
+ * @brief Compares a summary against history.tdd before it is saved
+ * @param[in,out] summary Sets regressed, baseline_time and per benchmark verdicts
+ * @return Number of regressions
+ * @note  Needs TDD_HISTORY_MIN_RUNS runs of history; suites faster than
+ *        TDD_HISTORY_MIN_SECONDS are not judged on time
+ */
+int tdd_check_regressions(test_summary_t* summary);
+
 #endif
@@ -0,0 +1,421 @@
+#if defined(__unix__) && !defined(__WATCOMC__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L     // fork, clock_gettime
+#endif
+
+#include "tdd_runner.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tdd_counters.h"
+#include "tdd_death.h"
+
+#ifdef TDD_RUNNER_FORK
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+bool tdd_glob_match(const char* pattern, const char* text) {
+    assert(pattern && "NULL pattern!");
+    assert(text && "NULL text!");
+    const char* star = NULL;
+    const char* resume = NULL;
+    while (*text) {
+        if (*pattern == '*') {
+            star = pattern++;
+            resume = text;
+        }
+        else if (*pattern == '?' || tolower((unsigned char)*pattern) == tolower((unsigned char)*text)) {
+            ++pattern;
+            ++text;
+        }
+        else if (star) {            // let the last * swallow one more character
+            pattern = star + 1;
+            text = ++resume;
+        }
+        else {
+            return false;
+        }
+    }
+    while (*pattern == '*') {
+        ++pattern;
+    }
+    return !*pattern;
+}
+
+static void private_tdd_usage(const char* program) {
+    printf("usage: %s [glob] [--bench-only] [--repeat N] [--jobs N] [--format=console|json|verbose|silent] [--list]\n"
+           "  glob matches suite, test or suite/test e.g. mda* or xt_tt/*snapshot\n"
+           "  suites that wait for a key run only when a glob is given\n", program);
+}
+
+static uint16_t private_tdd_default_jobs() {
+    const char* jobs = getenv("TDD_JOBS");
+    return (jobs && atoi(jobs) > 0) ? (uint16_t)atoi(jobs) : 1;
+}
+
+bool tdd_parse_args(int argc, char** argv, tdd_options_t* options) {
+    assert(options && "NULL options!");
+    options->filter = NULL;
+    options->bench_only = false;
+    options->list = false;
+    options->repeat = 1;
+    options->jobs = private_tdd_default_jobs();
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--bench-only") == 0) {
+            options->bench_only = true;
+        }
+        else if (strcmp(arg, "--list") == 0) {
+            options->list = true;
+        }
+        else if (strcmp(arg, "--repeat") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            options->repeat = (uint16_t)atoi(argv[++i]);
+        }
+        else if (strcmp(arg, "--jobs") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            options->jobs = (uint16_t)atoi(argv[++i]);
+        }
+        else if (strcmp(arg, "--format=console") == 0) {
+            tdd_set_format(REPORT_CONSOLE);
+        }
+        else if (strcmp(arg, "--format=json") == 0) {
+            tdd_set_format(REPORT_JSON);
+        }
+        else if (strcmp(arg, "--format=verbose") == 0) {
+            tdd_set_format(REPORT_VERBOSE);
+        }
+        else if (strcmp(arg, "--format=silent") == 0) {
+            tdd_set_format(REPORT_SILENT);
+        }
+        else if (arg[0] != '-' && !options->filter) {
+            options->filter = arg;
+        }
+        else {
+            private_tdd_usage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool private_tdd_unattended(const tdd_options_t* options, const tdd_suite_t* suite) {
+    return !suite->interactive || (options && options->filter);
+}
+
+static bool private_tdd_selected(const tdd_options_t* options, const char* suite, const char* name) {
+    if (!options || !options->filter) {
+        return true;
+    }
+    char path[TDD_RUNNER_NAME_SIZE];
+    snprintf(path, sizeof(path), "%s/%s", suite, name);
+    return tdd_glob_match(options->filter, suite)
+        || tdd_glob_match(options->filter, name)
+        || tdd_glob_match(options->filter, path);
+}
+
+/**
+ * @brief Runs one test, turning an abort inside it into a failure
+ * @note A fresh frame per call keeps the locals the longjmp returns to out of registers
+ */
+static bool private_tdd_isolated_test(const test_t* test) {
+    jmp_buf jump;
+    jmp_buf* volatile previous = NULL;
+    bool passed = true;
+    if (setjmp(jump) == 0) {
+        previous = tdd_death_arm(&jump);
+        test->fn(&passed);
+        tdd_death_disarm(previous);
+        return passed;
+    }
+    tdd_death_disarm(previous);
+    printf("\n%s - ABORTED, continuing\n", test->name);
+    return false;
+}
+
+static bool private_tdd_isolated_bench(const bench_t* bench, tdd_bench_result_t* result) {
+    jmp_buf jump;
+    jmp_buf* volatile previous = NULL;
+    if (setjmp(jump) == 0) {
+        previous = tdd_death_arm(&jump);
+        tdd_bench_run(bench, result);
+        tdd_death_disarm(previous);
+        return true;
+    }
+    tdd_death_disarm(previous);
+    printf("\n%s - ABORTED, continuing\n", bench->name);
+    return false;
+}
+
+static test_summary_t last_summary;
+
+/**
+ * @brief Reports a suite, judging and recording it only when it is comparable to its history
+ * @param comparable False for filtered subsets and forked (wall-clock timed) runs,
+ *        which would otherwise skew the baseline kept under the suite name
+ * @param counted False when the tests ran in workers, whose counters are not merged
+ */
+static void private_tdd_finish(test_summary_t* summary, bool comparable, bool counted) {
+    if (comparable) {
+        tdd_check_regressions(summary);
+    }
+    tdd_generate_report(*summary, stdout);
+    if (counted) {
+        tdd_counters_report(stdout);
+    }
+    if (comparable) {
+        tdd_save_history(*summary);
+    }
+    last_summary = *summary;
+    last_summary.benches = NULL;        // freed once the bench suite returns
+    last_summary.bench_count = 0;
+}
+
+test_summary_t tdd_last_summary() {
+    return last_summary;
+}
+
+#ifdef TDD_RUNNER_FORK
+
+typedef struct {
+    pid_t pid;          ///< 0 when not selected
+    FILE* output;       ///< Worker stdout and stderr, replayed in suite order
+    bool done;
+    bool passed;
+} private_tdd_worker_t;
+
+static double private_tdd_wall_clock() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1.0e9;
+}
+
+/**
+ * @brief Waits for one of the first count workers to end
+ * @return Workers marked done - 1, or every outstanding one (as failed) if no child is left
+ */
+static uint16_t private_tdd_reap(private_tdd_worker_t* workers, uint16_t count) {
+    for (;;) {
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0 && errno == EINTR) {
+            continue;
+        }
+        if (pid < 0) {                          // ECHILD - lost track, fail what is left
+            uint16_t lost = 0;
+            for (uint16_t i = 0; i < count; ++i) {
+                if (workers[i].pid > 0 && !workers[i].done) {
+                    fprintf(workers[i].output, "\n(worker lost)\n");
+                    workers[i].done = true;
+                    workers[i].passed = false;
+                    ++lost;
+                }
+            }
+            return lost;
+        }
+        for (uint16_t i = 0; i < count; ++i) {
+            if (workers[i].pid == pid && !workers[i].done) {
+                workers[i].done = true;
+                workers[i].passed = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+                if (WIFSIGNALED(status)) {
+                    fprintf(workers[i].output, "\n(worker killed by signal %d)\n", WTERMSIG(status));
+                }
+                return 1;
+            }
+        }
+    }
+}
+
+static void private_tdd_replay(private_tdd_worker_t* worker) {
+    int c;
+    rewind(worker->output);
+    while ((c = fgetc(worker->output)) != EOF) {
+        putchar(c);
+    }
+    fclose(worker->output);
+    worker->output = NULL;
+}
+
+static void private_tdd_collect(private_tdd_worker_t* workers, uint16_t* reported, uint16_t limit, test_summary_t* summary) {
+    for (; *reported < limit; ++*reported) {
+        private_tdd_worker_t* w = &workers[*reported];
+        if (!w->pid) {
+            continue;                           // not selected
+        }
+        if (!w->done) {
+            return;                             // keeps the report in suite order
+        }
+        if (w->output) {
+            private_tdd_replay(w);
+        }
+        summary->total++;
+        w->passed ? summary->passed++ : summary->failed++;
+    }
+}
+
+/**
+ * @brief Forks up to jobs workers, one per selected test, and tallies them in suite order
+ */
+static void private_tdd_run_forked(const tdd_suite_t* suite, const tdd_options_t* options, uint16_t jobs, test_summary_t* summary) {
+    private_tdd_worker_t* workers = (private_tdd_worker_t*)calloc(suite->count, sizeof(private_tdd_worker_t));
+    assert(workers && "OUT OF memory!");
+    uint16_t running = 0;
+    uint16_t reported = 0;
+    for (uint16_t i = 0; i < suite->count; ++i) {
+        if (!private_tdd_selected(options, suite->name, suite->tests[i]->name)) {
+            continue;
+        }
+        while (running == jobs) {
+            running -= private_tdd_reap(workers, i);
+        }
+        private_tdd_collect(workers, &reported, i, summary);
+        workers[i].output = tmpfile();
+        fflush(stdout);                         // the child must not inherit replayed output
+        fflush(stderr);
+        pid_t pid = (workers[i].output) ? fork() : -1;
+        if (pid == 0) {
+            dup2(fileno(workers[i].output), STDOUT_FILENO);
+            dup2(fileno(workers[i].output), STDERR_FILENO);
+            bool passed = private_tdd_isolated_test(suite->tests[i]);
+            fflush(stdout);
+            _exit(passed ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        if (pid < 0) {                          // no worker - drain the others, then run it here
+            while (running) {
+                running -= private_tdd_reap(workers, i);
+            }
+            private_tdd_collect(workers, &reported, i, summary);
+            if (workers[i].output) {
+                fclose(workers[i].output);
+                workers[i].output = NULL;
+            }
+            workers[i].pid = -1;
+            workers[i].passed = private_tdd_isolated_test(suite->tests[i]);
+            workers[i].done = true;
+        }
+        else {
+            workers[i].pid = pid;
+            ++running;
+        }
+    }
+    while (running) {
+        running -= private_tdd_reap(workers, suite->count);
+    }
+    private_tdd_collect(workers, &reported, suite->count, summary);
+    free(workers);
+}
+
+#endif
+
+int tdd_run_suite(const tdd_suite_t* suite, const tdd_options_t* options) {
+    assert(suite && "NULL suite!");
+    test_summary_t summary = {0};
+    summary.suite_name = suite->name;
+    tdd_counters_reset();
+#ifdef TDD_RUNNER_FORK
+    uint16_t jobs = (options) ? options->jobs : private_tdd_default_jobs();
+    if (jobs > 1) {
+        double wall = private_tdd_wall_clock();
+        private_tdd_run_forked(suite, options, jobs, &summary);
+        if (!summary.total) {
+            return 0;
+        }
+        summary.time_elapsed = private_tdd_wall_clock() - wall;
+        private_tdd_finish(&summary, false, false);
+        return summary.failed + summary.regressed;
+    }
+#endif
+    clock_t start = clock();
+
+    for (uint16_t i = 0; i < suite->count; i++) {
+        if (!private_tdd_selected(options, suite->name, suite->tests[i]->name)) {
+            continue;
+        }
+        bool passed = private_tdd_isolated_test(suite->tests[i]);
+        summary.total++;
+        passed ? summary.passed++ : summary.failed++;
+    }
+    if (!summary.total) {
+        return 0;       // filtered out - no report, no history
+    }
+
+    summary.time_elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    private_tdd_finish(&summary, !options || !options->filter, true);
+    return summary.failed + summary.regressed;
+}
+
+int tdd_run_bench_suite(const tdd_bench_suite_t* suite, const tdd_options_t* options) {
+    assert(suite && "NULL suite!");
+    tdd_bench_result_t* results = (tdd_bench_result_t*)malloc(suite->count * sizeof(tdd_bench_result_t));
+    if (!results) {
+        return 0;
+    }
+    test_summary_t summary = {0};
+    summary.suite_name = suite->name;
+    tdd_counters_reset();
+    tdd_bench_begin();
+    uint64_t start = tdd_bench_now();
+
+    for (uint16_t i = 0; i < suite->count; i++) {
+        if (!private_tdd_selected(options, suite->name, suite->benches[i]->name)) {
+            continue;
+        }
+        if (private_tdd_isolated_bench(suite->benches[i], &results[summary.bench_count])) {
+            summary.bench_count++;
+            summary.passed++;
+        }
+        else {
+            summary.failed++;
+        }
+        summary.total++;
+    }
+
+    summary.time_elapsed = (double)(tdd_bench_now() - start) / tdd_bench_ticks_per_second();
+    tdd_bench_end();
+    if (summary.total) {
+        summary.benches = results;
+        private_tdd_finish(&summary, !options || !options->filter, true);
+    }
+    free(results);
+    return summary.failed + summary.regressed;
+}
+
+int tdd_run(const tdd_suite_t* const* suites, uint16_t suite_count,
+            const tdd_bench_suite_t* const* bench_suites, uint16_t bench_suite_count,
+            const tdd_options_t* options) {
+    assert(options && "NULL options!");
+    if (options->list) {
+        for (uint16_t s = 0; s < suite_count && !options->bench_only; ++s) {
+            for (uint16_t i = 0; i < suites[s]->count && private_tdd_unattended(options, suites[s]); ++i) {
+                if (private_tdd_selected(options, suites[s]->name, suites[s]->tests[i]->name)) {
+                    printf("%s/%s\n", suites[s]->name, suites[s]->tests[i]->name);
+                }
+            }
+        }
+        for (uint16_t s = 0; s < bench_suite_count; ++s) {
+            for (uint16_t i = 0; i < bench_suites[s]->count; ++i) {
+                if (private_tdd_selected(options, bench_suites[s]->name, bench_suites[s]->benches[i]->name)) {
+                    printf("%s/%s (bench)\n", bench_suites[s]->name, bench_suites[s]->benches[i]->name);
+                }
+            }
+        }
+        return 0;
+    }
+    int failures = 0;
+    for (uint16_t r = 0; r < options->repeat; ++r) {
+        for (uint16_t s = 0; s < suite_count && !options->bench_only; ++s) {
+            if (private_tdd_unattended(options, suites[s])) {
+                failures += tdd_run_suite(suites[s], options);
+            }
+        }
+        for (uint16_t s = 0; s < bench_suite_count; ++s) {
+            failures += tdd_run_bench_suite(bench_suites[s], options);
+        }
+    }
+    return failures;
+}
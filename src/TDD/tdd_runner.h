@@ -0,0 +1,134 @@
+/**
+ * @file tdd_runner.h
+ * @brief Named suites in one binary, selected from the command line
+ * @details
+ * @code
+ * TDD_SUITE(mda, MDA_CONTEXT_TESTS);
+ * TDD_BENCH_SUITE(popcnt, POPCNT_BENCHMARKS);
+ *
+ * static const tdd_suite_t* const suites[] = {&mda};
+ * static const tdd_bench_suite_t* const bench_suites[] = {&popcnt};
+ *
+ * int main(int argc, char** argv) {
+ *     tdd_options_t options;
+ *     if (!tdd_parse_args(argc, argv, &options)) return EXIT_FAILURE;
+ *     return tdd_run(suites, 1, bench_suites, 1, &options) ? EXIT_FAILURE : EXIT_SUCCESS;
+ * }
+ * @endcode
+ *
+ * CHESS mda_* --repeat 3     tests of suite mda matching mda_*, three times
+ * CHESS --bench-only popcnt   only the popcnt benchmarks
+ * CHESS --list                names only, suite/test
+ * chess --jobs 8 perft*       host build only, eight tests at a time
+ * @ingroup tdd_framework
+ */
+#ifndef TDD_RUNNER_H
+#define TDD_RUNNER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tdd_types.h"
+#include "tdd_bench.h"
+#include "tdd_report.h"
+
+#define TDD_RUNNER_NAME_SIZE 64    // "suite/test" for matching
+
+#if defined(__unix__) && !defined(__WATCOMC__)
+#define TDD_RUNNER_FORK             // host build - tests can run in worker processes
+#endif
+
+typedef struct {
+    const char* name;
+    const test_t* const* tests;
+    uint16_t count;
+    bool interactive;       ///< Waits for the user - run only when a filter selects it
+} tdd_suite_t;
+
+typedef struct {
+    const char* name;
+    const bench_t* const* benches;
+    uint16_t count;
+} tdd_bench_suite_t;
+
+typedef struct {
+    const char* filter;     ///< Glob over suite, test or suite/test - NULL selects all
+    bool bench_only;        ///< Skip test suites
+    bool list;              ///< Print the selection instead of running it
+    uint16_t repeat;        ///< Runs of the whole selection, at least 1
+    uint16_t jobs;          ///< Tests run at once, forked workers on the host build only
+} tdd_options_t;
+
+/**
+ * @brief Declares a named test suite
+ * @param suite Suite name, also the name used by filters
+ * @param ...   Test cases e.g. MDA_CONTEXT_TESTS
+ */
+#define TDD_SUITE(suite, ...)                                               \
+    static const test_t* const suite##_cases[] = {__VA_ARGS__};             \
+    static const tdd_suite_t suite = {#suite, suite##_cases, sizeof(suite##_cases)/sizeof(suite##_cases[0]), false}
+
+/**
+ * @brief Declares a suite that waits for the user, left out of runs without a filter
+ */
+#define TDD_INTERACTIVE_SUITE(suite, ...)                                   \
+    static const test_t* const suite##_cases[] = {__VA_ARGS__};             \
+    static const tdd_suite_t suite = {#suite, suite##_cases, sizeof(suite##_cases)/sizeof(suite##_cases[0]), true}
+
+/**
+ * @brief Declares a named benchmark suite
+ */
+#define TDD_BENCH_SUITE(suite, ...)                                         \
+    static const bench_t* const suite##_cases[] = {__VA_ARGS__};            \
+    static const tdd_bench_suite_t suite = {#suite, suite##_cases, sizeof(suite##_cases)/sizeof(suite##_cases[0])}
+
+/**
+ * @brief Case insensitive match with * and ?
+ */
+bool tdd_glob_match(const char* pattern, const char* text);
+
+/**
+ * @brief Reads [glob] --bench-only --repeat N --jobs N --format=console|json|verbose|silent --list
+ * @note  --jobs defaults to the TDD_JOBS environment variable, else 1
+ * @note  Sets the report format as a side effect, prints usage on error
+ * @return false on an unknown option
+ */
+bool tdd_parse_args(int argc, char** argv, tdd_options_t* options);
+
+/**
+ * @brief Runs the selected tests of a suite, reports and saves history
+ * @details A test that aborts (failed assert) is counted as failed and the suite continues.
+ *          With more than one job each test runs in its own forked process; output is
+ *          replayed in suite order so reports do not depend on which worker ends first.
+ *          Counters incremented inside workers are not merged, so no counter report
+ *          is printed for a forked run.
+ *          Filtered and forked runs are reported but neither judged against nor saved to history.
+ * @param options NULL runs every test once, jobs from TDD_JOBS
+ * @return Failed tests plus time regressions
+ */
+int tdd_run_suite(const tdd_suite_t* suite, const tdd_options_t* options);
+
+/**
+ * @brief Runs the selected benchmarks of a suite, reports and saves history
+ * @details Filtered runs are reported but neither judged against nor saved to history.
+ * @param options NULL runs every benchmark once
+ * @return Aborted benchmarks plus those slower than their history.tdd baseline
+ */
+int tdd_run_bench_suite(const tdd_bench_suite_t* suite, const tdd_options_t* options);
+
+/**
+ * @brief Totals of the most recently reported suite, without its benchmark results
+ * @note Lets tests check what a run merged, e.g. from forked workers
+ */
+test_summary_t tdd_last_summary();
+
+/**
+ * @brief Lists or runs the selection options->repeat times
+ * @details Interactive suites are only part of the selection when options->filter is set
+ * @return Sum of failures and regressions over all runs
+ */
+int tdd_run(const tdd_suite_t* const* suites, uint16_t suite_count,
+            const tdd_bench_suite_t* const* bench_suites, uint16_t bench_suite_count,
+            const tdd_options_t* options);
+
+#endif
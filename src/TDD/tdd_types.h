@@ -1,8 +1,17 @@
 #ifndef TDD_TYPES_H
 #define TDD_TYPES_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 typedef uint32_t tdd_size_t;
 
+/**
+ * @brief Test case structure
+ */
+typedef struct {
+    void (*fn)(bool*);   /**< Test function pointer */
+    char *name;          /**< Test name */
+} test_t;
+
 #endif
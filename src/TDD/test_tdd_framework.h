@@ -10,13 +10,32 @@
 
 #include "tdd_macros.h"
 #include "tdd_report.h"
+#include "tdd_constants.h"
+#include "tdd_profiler.h"
+#include "tdd_runner.h"
+
+#include <assert.h>
+
+#ifdef TDD_RUNNER_FORK
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define TDD_FRAMEWORK_TESTS \
     &test_expect_macros,     \
     &test_string_macros,     \
     &test_pointer_macros,    \
     &test_report_formats,    \
-    &test_historical_tracking
+    &test_historical_tracking, \
+    &test_regression_detection, \
+    &test_bench_histogram, \
+    &test_death_macros, \
+    &test_glob_match, \
+    &test_parse_args, \
+    &test_forked_runner
+
+#define TDD_PROFILER_TESTS \
+    &test_profiler_samples
 
 // =============================================
 // Test Cases (Testing the Tester!)
@@ -110,4 +129,216 @@ TEST(test_historical_tracking) {
     }
 }
 
+TEST(test_regression_detection) {
+    tdd_bench_result_t bench = {.name = "bench_dummy", .samples = 7, .median_ns = 100.0};
+    test_summary_t dummy = {
+        .total = 1,
+        .passed = 1,
+        .suite_name = "test_regression",
+        .benches = &bench,
+        .bench_count = 1
+    };
+    const double times[] = {2.0, 2.2, 1.8};
+    double baseline;
+
+    for (int i = 0; i < 3; ++i) {
+        dummy.time_elapsed = times[i];
+        tdd_save_history(dummy);
+    }
+    EXPECT(tdd_history_baseline("test_regression", &baseline) >= TDD_HISTORY_MIN_RUNS);
+    EXPECT(baseline > 1.9 && baseline < 2.1);           // median, not mean
+    EXPECT(tdd_history_baseline("test_regression:bench_dummy", &baseline) >= TDD_HISTORY_MIN_RUNS);
+    EXPECT(baseline > 99.0 && baseline < 101.0);
+    EXPECT_EQ(tdd_history_baseline("test_never_run", &baseline), 0);
+
+    dummy.time_elapsed = 2.1;                           // within 10%
+    EXPECT_EQ(tdd_check_regressions(&dummy), 0);
+    EXPECT(!bench.regressed);
+    dummy.time_elapsed = 2.5;
+    bench.median_ns = 115.0;
+    EXPECT_EQ(tdd_check_regressions(&dummy), 2);
+    EXPECT(bench.regressed);
+    tdd_set_regression_threshold(20);
+    EXPECT_EQ(tdd_check_regressions(&dummy), 1);        // suite 25% slower, bench 15%
+    tdd_set_regression_threshold(TDD_REGRESSION_THRESHOLD);
+}
+
+TEST(test_bench_histogram) {
+    EXPECT_EQ(tdd_bench_bucket(0), 0);
+    EXPECT_EQ(tdd_bench_bucket(1), 1);
+    EXPECT_EQ(tdd_bench_bucket(3), 2);
+    EXPECT_EQ(tdd_bench_bucket(4), 3);
+    EXPECT_EQ(tdd_bench_bucket(0xFFFFFFFFULL), TDD_BENCH_BUCKETS - 1);  // open ended tail
+
+    tdd_bench_result_t bench = {.name = "bench_dummy", .bucket_ns = 838.1};
+    bench.histogram[2] = 200;
+    bench.histogram[3] = 50;
+    bench.histogram[9] = 6;                                             // disk sized stall
+    tdd_bench_plot(&bench);
+    test_summary_t dummy = {
+        .total = 1,
+        .passed = 1,
+        .suite_name = "test_histogram",
+        .benches = &bench,
+        .bench_count = 1
+    };
+    tdd_set_format(REPORT_JSON);
+    tdd_generate_report(dummy, stdout);
+    tdd_set_format(REPORT_CONSOLE);
+}
+
+TEST(test_profiler_samples) {
+    mem_arena_t* arena = mem_arena_create(MEM_ARENA_POLICY_DOS, 8192);
+    ASSERT(arena != NULL);
+    ASSERT(tdd_profiler_start(arena, 1024));
+    EXPECT(!tdd_profiler_start(arena, 1024));          // already hooked
+    clock_t until = clock() + CLOCKS_PER_SEC / 2;
+    while (clock() < until) {                           // BIOS time of day must keep moving
+        TDD_BENCH_KEEP(until);
+    }
+    tdd_profiler_stop();
+    V(printf("%lu samples, %lu dropped\n", tdd_profiler_samples(), tdd_profiler_dropped()););
+    EXPECT(tdd_profiler_samples() > 50);                // ~145 at 291 Hz
+    EXPECT(tdd_profiler_save("PROFILE.TMP"));
+    FILE* f = fopen("PROFILE.TMP", "rb");
+    EXPECT_NOT_NULL(f);
+    if (f) {
+        tdd_profiler_header_t header;
+        EXPECT_EQ(fread(&header, sizeof(header), 1, f), 1);
+        EXPECT(memcmp(header.magic, TDD_PROFILER_MAGIC, 4) == 0);
+        EXPECT_EQ(header.samples, tdd_profiler_samples());
+        fclose(f);
+    }
+    remove("PROFILE.TMP");
+    tdd_profiler_release();
+    EXPECT(!tdd_profiler_save("PROFILE.TMP"));          // nothing left pointing into the arena
+    mem_arena_delete(arena);
+}
+
+static void tdd_death_nested(void) {
+    bool inner = true;
+    bool* pass = &inner;
+    EXPECT_DEATH(abort());              // caught by the innermost jump
+    assert(inner && "inner death test leaked!");
+    abort();
+}
+
+TEST(test_death_macros) {
+    EXPECT_DEATH(abort());
+    EXPECT_DEATH(assert(0 && "expected"));
+    EXPECT_DEATH(tdd_death_nested());
+
+    bool survived = true;
+    {
+        bool* pass = &survived;         // a statement that returns is a failure
+        EXPECT_DEATH((void)0);
+    }
+#ifndef NDEBUG
+    EXPECT(!survived);
+#endif
+}
+
+TEST(test_glob_match) {
+    EXPECT(tdd_glob_match("mda*", "mda"));
+    EXPECT(tdd_glob_match("*", ""));
+    EXPECT(tdd_glob_match("a*b*c", "aXbYbZc"));         // * backtracks past an early b
+    EXPECT(tdd_glob_match("*snapshot", "test_snapshot_snapshot"));
+    EXPECT(!tdd_glob_match("a*b", "aXbY"));
+    EXPECT(tdd_glob_match("te?t", "test"));
+    EXPECT(!tdd_glob_match("te?t", "tet"));
+    EXPECT(tdd_glob_match("XT_TT", "xt_tt"));           // case folded
+    EXPECT(tdd_glob_match("xt_tt/*snapshot", "xt_tt/test_xt_tt_snapshot"));
+    EXPECT(!tdd_glob_match("xt_tt/*snapshot", "mda/test_snapshot"));
+    EXPECT(!tdd_glob_match("mda", "mda_extra"));
+}
+
+TEST(test_parse_args) {
+    tdd_options_t options;
+    char program[] = "test";
+    char glob[] = "mda*";
+    char repeat[] = "--repeat";
+    char three[] = "3";
+    char zero[] = "0";
+    char bench[] = "--bench-only";
+    char list[] = "--list";
+    char unknown[] = "--frobnicate";
+
+    char* plain[] = {program};
+    ASSERT(tdd_parse_args(1, plain, &options));
+    EXPECT_NULL(options.filter);
+    EXPECT_EQ(options.repeat, 1);
+    EXPECT(!options.bench_only && !options.list);
+
+    char* full[] = {program, glob, repeat, three, bench, list};
+    ASSERT(tdd_parse_args(6, full, &options));
+    EXPECT_STREQ(options.filter, "mda*");
+    EXPECT_EQ(options.repeat, 3);
+    EXPECT(options.bench_only && options.list);
+
+    V(printf("Expect two usage lines:\n"););
+    char* no_repeats[] = {program, repeat, zero};
+    EXPECT(!tdd_parse_args(3, no_repeats, &options));
+    char* bad[] = {program, unknown};
+    EXPECT(!tdd_parse_args(2, bad, &options));
+}
+
+#ifdef TDD_RUNNER_FORK
+TEST(tdd_fork_slow) {
+    for (volatile uint32_t i = 0; i < 20000000UL; ++i) {}   // ends after its successors
+    printf("<slow>");
+    EXPECT(true);
+}
+
+TEST(tdd_fork_fails) {
+    printf("<fails>");
+    *pass = false;
+}
+
+TEST(tdd_fork_aborts) {
+    printf("<aborts>");
+    abort();
+}
+#endif
+
+TEST(test_forked_runner) {
+#ifdef TDD_RUNNER_FORK
+    static const test_t* const cases[] = {&tdd_fork_slow, &tdd_fork_fails, &tdd_fork_aborts};
+    const tdd_suite_t suite = {"forked", cases, 3, false};
+    tdd_options_t options = {NULL, false, false, 1, 3};
+
+    int capture = open("FORKED.TMP", O_RDWR | O_CREAT | O_TRUNC, 0600);
+    ASSERT(capture >= 0);
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    dup2(capture, STDOUT_FILENO);
+    int failures = tdd_run_suite(&suite, &options);
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    close(capture);
+
+    char output[2048] = {0};
+    FILE* f = fopen("FORKED.TMP", "r");
+    ASSERT(f != NULL);
+    fread(output, 1, sizeof(output) - 1, f);
+    fclose(f);
+    remove("FORKED.TMP");
+
+    test_summary_t summary = tdd_last_summary();
+    EXPECT_EQ(failures, 2);
+    EXPECT_EQ(summary.total, 3);
+    EXPECT_EQ(summary.passed, 1);
+    EXPECT_EQ(summary.failed, 2);                       // the abort counts as a failure
+
+    // Replayed in suite order although the first worker ends last
+    const char* slow = strstr(output, "<slow>");
+    const char* fails = strstr(output, "<fails>");
+    const char* aborts = strstr(output, "<aborts>");
+    EXPECT(slow && fails && aborts);
+    EXPECT(slow < fails && fails < aborts);
+#else
+    V(printf("No forked workers on this build - skipped\n"););
+#endif
+}
+
 #endif
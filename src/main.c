@@ -1,31 +1,62 @@
 #include <stdlib.h>
 #include "TDD/tdd_macros.h"
 
-// #include " CHESS/test_chess.h"
-// #include "BIOS/test_bios.h"
+#include "BIOS/test_bios.h"
+#include "CHESS/test_chess.h"
+#include "DOS/test_dos_services.h"
+#include "DOS/test_dos_bstream.h"
 #include "MDA/test_mda_context.h"
+#include "MEM/test_mem_arena.h"
+#include "MEM/test_mem_pool.h"
+#include "MEM/test_mem_ems.h"
+#include "MEM/test_mem_tools.h"
+#include "TDD/test_tdd_framework.h"
+#include "TDD/test_tdd_spinners.h"
 
 /**
  * TODO:
- * [ ] bios scrolling
+ * [x] bios scrolling
  * [ ] upgraded context
  * [...] widget composite pattern
  *  [ ] widget panel
  *  [ ] widget border
- *  [ ] widget chess board
+ *  [x] widget chess board
  * [ ] maps
  * [ ] locations with doors
  * [ ] parse moving around locations
  */
 
-RUN_TESTS(
-    //POPCNT_TEST_SUITE
-    //BIOS_VIDEO_TESTS
-    MDA_CONTEXT_TESTS
-)
+TDD_INTERACTIVE_SUITE(mda, MDA_CONTEXT_TESTS);    // mda_context_test waits for a key
+TDD_SUITE(popcnt, POPCNT_TEST_SUITE);
+TDD_SUITE(xt_tt, XT_TT_TESTS);
+TDD_SUITE(arena, ARENA_TESTS);
+TDD_SUITE(pool, POOL_TESTS);
+TDD_SUITE(ems, EMS_TESTS);
+TDD_SUITE(mem_tools, TOOLS_TESTS);
+TDD_SUITE(dos, DOS_SERVICES_TESTS);
+TDD_SUITE(bstream, DOS_BSTREAM_TESTS);
+TDD_SUITE(pit, BIOS_TIMER_TESTS);
+TDD_SUITE(tdd, TDD_FRAMEWORK_TESTS);
+TDD_SUITE(tdd_progress, TDD_TESTS);
+TDD_SUITE(profiler, TDD_PROFILER_TESTS);
+TDD_INTERACTIVE_SUITE(bios_video, BIOS_VIDEO_TESTS);  // waits for a key
 
-int main(int argc, char** argv) {
+TDD_BENCH_SUITE(popcnt_bench, POPCNT_BENCHMARKS);
+
+static const tdd_suite_t* const suites[] = {
+    &mda, &popcnt, &xt_tt, &arena, &pool, &ems, &mem_tools, &dos, &bstream,
+    &pit, &tdd, &tdd_progress, &profiler, &bios_video
+};
 
-    return (run_tests()) ? EXIT_FAILURE : EXIT_SUCCESS;
+static const tdd_bench_suite_t* const bench_suites[] = {
+    &popcnt_bench
+};
 
+int main(int argc, char** argv) {
+    tdd_options_t options;
+    if (!tdd_parse_args(argc, argv, &options)) {
+        return EXIT_FAILURE;
+    }
+    return (tdd_run(suites, sizeof(suites) / sizeof(suites[0]),
+                    bench_suites, sizeof(bench_suites) / sizeof(bench_suites[0]), &options)) ? EXIT_FAILURE : EXIT_SUCCESS;
 }